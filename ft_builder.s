@@ -0,0 +1,321 @@
+global ft_builder_init
+global ft_builder_append
+global ft_builder_append_ref
+global ft_builder_flush
+global ft_builder_free
+extern malloc
+extern realloc
+extern free
+extern __errno_location
+
+; t_ft_builder layout (see libasm.h)
+%define B_IOV       0               ; struct iovec *iov
+%define B_IOVCNT    8               ; size_t iovcnt
+%define B_IOVCAP    16              ; size_t iovcap
+%define B_CHUNKS    24              ; t_ft_chunk *chunks (newest first)
+%define B_TOTAL     32              ; size_t total
+
+; t_ft_chunk layout
+%define C_NEXT      0
+%define C_USED      8
+%define C_DATA      16
+%define CHUNK       4096            ; FT_BUILDER_CHUNK
+%define CHUNK_ALLOC 4112            ; sizeof(t_ft_chunk)
+
+%define COPY_MAX    512             ; FT_BUILDER_COPY_MAX
+%define IOV_MAX     1024            ; kernel limit per writev call
+%define SYS_WRITEV  20
+
+section .text
+
+ft_builder_init:
+    xor     eax, eax
+    mov     [rdi + B_IOV], rax
+    mov     [rdi + B_IOVCNT], rax
+    mov     [rdi + B_IOVCAP], rax
+    mov     [rdi + B_CHUNKS], rax
+    mov     [rdi + B_TOTAL], rax
+    ret
+
+builder_push_iov:
+    ; rdi = builder, rsi = base, rdx = len -> eax = 0 or -1
+    mov     rcx, [rdi + B_IOVCNT]
+    test    rcx, rcx
+    jz      .append
+
+    ; Extend the previous iovec when the bytes are contiguous
+    mov     rax, rcx
+    shl     rax, 4                      ; sizeof(struct iovec) == 16
+    add     rax, [rdi + B_IOV]          ; rax = &iov[iovcnt]
+    mov     r8, [rax - 16]              ; previous iov_base
+    add     r8, [rax - 8]               ; + previous iov_len
+    cmp     r8, rsi
+    jne     .append
+    add     [rax - 8], rdx              ; merge
+    xor     eax, eax
+    ret
+
+.append:
+    cmp     rcx, [rdi + B_IOVCAP]
+    jb      .store
+
+    ; iovec array is full: double it (first allocation holds 64)
+    push    rbx
+    push    r12
+    push    r13
+    push    r14
+    sub     rsp, 8                      ; keep the stack 16-byte aligned
+    mov     rbx, rdi
+    mov     r12, rsi
+    mov     r13, rdx
+    mov     r14, [rdi + B_IOVCAP]
+    add     r14, r14
+    mov     eax, 64
+    test    r14, r14
+    cmovz   r14, rax                    ; r14 = new capacity
+    mov     rdi, [rbx + B_IOV]
+    mov     rsi, r14
+    shl     rsi, 4
+    call    realloc wrt ..plt
+    test    rax, rax
+    jz      .grow_failed
+    mov     [rbx + B_IOV], rax
+    mov     [rbx + B_IOVCAP], r14
+    mov     rdi, rbx
+    mov     rsi, r12
+    mov     rdx, r13
+    add     rsp, 8
+    pop     r14
+    pop     r13
+    pop     r12
+    pop     rbx
+
+.store:
+    mov     rcx, [rdi + B_IOVCNT]
+    mov     rax, rcx
+    shl     rax, 4
+    add     rax, [rdi + B_IOV]          ; rax = &iov[iovcnt]
+    mov     [rax], rsi                  ; iov_base
+    mov     [rax + 8], rdx              ; iov_len
+    inc     rcx
+    mov     [rdi + B_IOVCNT], rcx
+    xor     eax, eax
+    ret
+
+.grow_failed:
+    mov     eax, -1                     ; errno already set by realloc
+    add     rsp, 8
+    pop     r14
+    pop     r13
+    pop     r12
+    pop     rbx
+    ret
+
+builder_free_chunks:
+    ; rdi = builder, releases every chunk
+    push    rbx
+    push    r12
+    sub     rsp, 8                      ; keep the stack 16-byte aligned
+    mov     rbx, rdi
+    mov     rdi, [rbx + B_CHUNKS]
+.loop:
+    test    rdi, rdi
+    jz      .end
+    mov     r12, [rdi + C_NEXT]
+    call    free wrt ..plt
+    mov     rdi, r12
+    jmp     .loop
+.end:
+    mov     qword [rbx + B_CHUNKS], 0
+    add     rsp, 8
+    pop     r12
+    pop     rbx
+    ret
+
+ft_builder_append:
+    ; rdi = builder, rsi = buf, rdx = len: copy into 4 KB chunks
+    push    rbx
+    push    r12
+    push    r13
+    push    r14
+    push    r15
+    mov     rbx, rdi                    ; rbx = builder
+    mov     r12, rsi                    ; r12 = source cursor
+    mov     r13, rdx                    ; r13 = bytes left
+
+.loop:
+    test    r13, r13
+    jz      .ok
+    mov     r14, [rbx + B_CHUNKS]       ; current chunk
+    test    r14, r14
+    jz      .new_chunk
+    mov     r15d, CHUNK
+    sub     r15, [r14 + C_USED]         ; r15 = room left in chunk
+    jnz     .copy
+
+.new_chunk:
+    mov     edi, CHUNK_ALLOC
+    call    malloc wrt ..plt
+    test    rax, rax
+    jz      .fail
+    mov     rcx, [rbx + B_CHUNKS]
+    mov     [rax + C_NEXT], rcx         ; push in front of the list
+    mov     qword [rax + C_USED], 0
+    mov     [rbx + B_CHUNKS], rax
+    mov     r14, rax
+    mov     r15d, CHUNK
+
+.copy:
+    cmp     r15, r13
+    cmova   r15, r13                    ; n = min(room, left)
+
+    ; Record the iovec first so a failure leaves the builder consistent
+    mov     rdi, rbx
+    lea     rsi, [r14 + C_DATA]
+    add     rsi, [r14 + C_USED]
+    mov     rdx, r15
+    call    builder_push_iov
+    test    eax, eax
+    jnz     .fail
+
+    lea     rdi, [r14 + C_DATA]
+    add     rdi, [r14 + C_USED]
+    mov     rsi, r12
+    mov     rcx, r15
+    rep     movsb                       ; copy the fragment
+    mov     r12, rsi                    ; advance source
+    add     [r14 + C_USED], r15
+    add     [rbx + B_TOTAL], r15
+    sub     r13, r15
+    jmp     .loop
+
+.ok:
+    xor     eax, eax
+    jmp     .end
+
+.fail:
+    mov     eax, -1                     ; errno already set by malloc/realloc
+
+.end:
+    pop     r15
+    pop     r14
+    pop     r13
+    pop     r12
+    pop     rbx
+    ret
+
+ft_builder_append_ref:
+    ; Small fragments are cheaper to copy than to give their own iovec
+    cmp     rdx, COPY_MAX
+    jb      ft_builder_append
+
+    push    rdi
+    push    rdx
+    sub     rsp, 8                      ; keep the stack 16-byte aligned
+    call    builder_push_iov            ; reference buf directly (zero-copy)
+    add     rsp, 8
+    pop     rdx
+    pop     rdi
+    test    eax, eax
+    jnz     .end
+    add     [rdi + B_TOTAL], rdx
+.end:
+    ret
+
+ft_builder_flush:
+    ; rdi = builder, esi = fd: emit everything with writev
+    push    rbx
+    push    r12
+    push    r13
+    push    r14
+    sub     rsp, 8                      ; keep the stack 16-byte aligned
+    mov     rbx, rdi                    ; rbx = builder
+    mov     r14d, esi                   ; r14 = fd
+    xor     r12d, r12d                  ; r12 = first unwritten iovec
+    xor     r13d, r13d                  ; r13 = bytes written
+
+.loop:
+    mov     rdx, [rbx + B_IOVCNT]
+    sub     rdx, r12                    ; iovecs left
+    jz      .done
+    mov     eax, IOV_MAX
+    cmp     rdx, rax
+    cmova   rdx, rax                    ; at most IOV_MAX per call
+    mov     rsi, r12
+    shl     rsi, 4
+    add     rsi, [rbx + B_IOV]          ; &iov[r12]
+    mov     edi, r14d
+    mov     eax, SYS_WRITEV
+    syscall
+    test    rax, rax
+    js      .error
+    add     r13, rax
+
+    ; Skip the iovecs fully written, trim the partially written one
+    mov     rsi, [rbx + B_IOV]
+.advance:
+    cmp     r12, [rbx + B_IOVCNT]
+    jae     .loop
+    mov     rcx, r12
+    shl     rcx, 4
+    mov     rdx, [rsi + rcx + 8]        ; iov_len
+    cmp     rax, rdx
+    jb      .partial
+    sub     rax, rdx
+    inc     r12
+    jmp     .advance
+
+.partial:
+    add     [rsi + rcx], rax            ; iov_base += written
+    sub     [rsi + rcx + 8], rax        ; iov_len -= written
+    jmp     .loop
+
+.done:
+    ; Everything is out: drop the chunks, keep the iovec array
+    mov     rdi, rbx
+    call    builder_free_chunks
+    mov     qword [rbx + B_IOVCNT], 0
+    mov     qword [rbx + B_TOTAL], 0
+    mov     rax, r13                    ; return bytes written
+    jmp     .end
+
+.error:
+    neg     rax
+    mov     r14, rax                    ; save error code
+
+    ; Drop the iovecs already written so the flush can be retried (EAGAIN)
+    sub     [rbx + B_TOTAL], r13
+    mov     rcx, [rbx + B_IOVCNT]
+    sub     rcx, r12
+    mov     [rbx + B_IOVCNT], rcx
+    shl     rcx, 4
+    mov     rdi, [rbx + B_IOV]
+    mov     rsi, r12
+    shl     rsi, 4
+    add     rsi, rdi
+    rep     movsb                       ; forward copy, dst < src
+
+    call    __errno_location wrt ..plt
+    mov     [rax], r14d                 ; store error code in errno
+    mov     rax, -1
+
+.end:
+    add     rsp, 8
+    pop     r14
+    pop     r13
+    pop     r12
+    pop     rbx
+    ret
+
+ft_builder_free:
+    push    rbx
+    mov     rbx, rdi
+    call    builder_free_chunks
+    mov     rdi, [rbx + B_IOV]
+    call    free wrt ..plt
+    mov     rdi, rbx
+    pop     rbx
+    jmp     ft_builder_init
+
+
+section .note.GNU-stack noalloc noexec nowrite progbits
@@ -0,0 +1,129 @@
+global ft_tolower_inplace
+global ft_toupper_inplace
+
+section .rodata
+align 16
+upper_bias:     times 16 db 0x3F        ; 'A'..'Z' + 0x3F -> -128..-103 (signed)
+lower_bias:     times 16 db 0x1F        ; 'a'..'z' + 0x1F -> -128..-103 (signed)
+alpha_limit:    times 16 db 0x9A        ; -102: first value past the letter range
+case_bit:       times 16 db 0x20        ; 'a' - 'A'
+
+section .text
+
+ft_tolower_inplace:
+    mov     rax, rdi                    ; return the original pointer
+    movdqa  xmm5, [rel upper_bias]
+    movdqa  xmm6, [rel alpha_limit]
+    movdqa  xmm7, [rel case_bit]
+    pxor    xmm4, xmm4
+
+.head:
+    ; Byte by byte until the pointer is 16-byte aligned
+    test    dil, 15
+    jz      .vector
+    movzx   ecx, byte [rdi]
+    test    ecx, ecx
+    jz      .end
+    lea     r8d, [rcx - 'A']
+    cmp     r8d, 26
+    sbb     r9d, r9d                    ; -1 if uppercase
+    and     r9d, 0x20
+    or      ecx, r9d
+    mov     [rdi], cl
+    inc     rdi
+    jmp     .head
+
+align 16
+.vector:
+    ; Aligned loads never cross a page, so reading past the end is safe
+    movdqa  xmm0, [rdi]
+    movdqa  xmm1, xmm0
+    pcmpeqb xmm1, xmm4
+    pmovmskb ecx, xmm1
+    test    ecx, ecx
+    jnz     .tail                       ; terminator in this block
+    movdqa  xmm2, xmm0
+    paddb   xmm2, xmm5
+    movdqa  xmm3, xmm6
+    pcmpgtb xmm3, xmm2                  ; 0xFF where 'A'..'Z'
+    pand    xmm3, xmm7
+    por     xmm0, xmm3                  ; set the case bit
+    movdqa  [rdi], xmm0
+    add     rdi, 16
+    jmp     .vector
+
+.tail:
+    ; Never write past the terminator: finish byte by byte
+    movzx   ecx, byte [rdi]
+    test    ecx, ecx
+    jz      .end
+    lea     r8d, [rcx - 'A']
+    cmp     r8d, 26
+    sbb     r9d, r9d
+    and     r9d, 0x20
+    or      ecx, r9d
+    mov     [rdi], cl
+    inc     rdi
+    jmp     .tail
+
+.end:
+    ret
+
+ft_toupper_inplace:
+    mov     rax, rdi                    ; return the original pointer
+    movdqa  xmm5, [rel lower_bias]
+    movdqa  xmm6, [rel alpha_limit]
+    movdqa  xmm7, [rel case_bit]
+    pxor    xmm4, xmm4
+
+.head:
+    test    dil, 15
+    jz      .vector
+    movzx   ecx, byte [rdi]
+    test    ecx, ecx
+    jz      .end
+    lea     r8d, [rcx - 'a']
+    cmp     r8d, 26
+    sbb     r9d, r9d                    ; -1 if lowercase
+    and     r9d, 0x20
+    xor     ecx, r9d
+    mov     [rdi], cl
+    inc     rdi
+    jmp     .head
+
+align 16
+.vector:
+    movdqa  xmm0, [rdi]
+    movdqa  xmm1, xmm0
+    pcmpeqb xmm1, xmm4
+    pmovmskb ecx, xmm1
+    test    ecx, ecx
+    jnz     .tail
+    movdqa  xmm2, xmm0
+    paddb   xmm2, xmm5
+    movdqa  xmm3, xmm6
+    pcmpgtb xmm3, xmm2                  ; 0xFF where 'a'..'z'
+    pand    xmm3, xmm7
+    pxor    xmm0, xmm3                  ; clear the case bit
+    movdqa  [rdi], xmm0
+    add     rdi, 16
+    jmp     .vector
+
+.tail:
+    movzx   ecx, byte [rdi]
+    test    ecx, ecx
+    jz      .end
+    lea     r8d, [rcx - 'a']
+    cmp     r8d, 26
+    sbb     r9d, r9d
+    and     r9d, 0x20
+    xor     ecx, r9d
+    mov     [rdi], cl
+    inc     rdi
+    jmp     .tail
+
+.end:
+    ret
+
+
+section .note.GNU-stack noalloc noexec nowrite progbits
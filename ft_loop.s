@@ -0,0 +1,327 @@
+global ft_loop_create
+global ft_loop_add_fd
+global ft_loop_del_fd
+global ft_loop_run
+global ft_loop_stop
+global ft_loop_destroy
+extern malloc
+extern realloc
+extern free
+extern __errno_location
+
+; t_ft_loop layout (see libasm.h)
+%define L_EPFD      0               ; int epfd
+%define L_RUNNING   4               ; int running
+%define L_NFDS      8               ; size_t nfds
+%define L_WATCHERS  16              ; t_ft_watcher *watchers (indexed by fd)
+%define L_CAP       24              ; size_t cap
+%define LOOP_SIZE   32
+
+; t_ft_watcher layout: 24 bytes, { cb, arg, gen }
+%define W_CB        0
+%define W_ARG       8
+%define W_GEN       16
+%define WATCHER_SIZE 24
+
+%define SYS_CLOSE           3
+%define SYS_EPOLL_WAIT      232
+%define SYS_EPOLL_CTL       233
+%define SYS_EPOLL_CREATE1   291
+%define EPOLL_CLOEXEC       0x80000
+%define EPOLL_CTL_ADD       1
+%define EPOLL_CTL_DEL       2
+%define EPOLL_CTL_MOD       3
+%define EPOLLET             0x80000000
+%define EINTR               4
+%define EBADF               9
+%define EINVAL              22
+
+%define MAX_EVENTS  64
+%define EVENTS_SIZE 768             ; MAX_EVENTS * sizeof(struct epoll_event) (packed, 12)
+
+section .text
+
+loop_fail:
+    ; rax = negative error code from the kernel: set errno, return -1
+    neg     rax                         ; make error code positive
+    push    rax                         ; save it (also aligns the stack)
+    call    __errno_location wrt ..plt
+    pop     rcx
+    mov     [rax], ecx                  ; store error code in errno
+    mov     eax, -1
+    ret
+
+ft_loop_create:
+    push    rbx
+    mov     edi, LOOP_SIZE
+    call    malloc wrt ..plt
+    test    rax, rax
+    jz      .end                        ; return NULL, errno set by malloc
+    mov     rbx, rax
+
+    mov     edi, EPOLL_CLOEXEC
+    mov     eax, SYS_EPOLL_CREATE1
+    syscall
+    test    rax, rax
+    js      .fail
+
+    mov     [rbx + L_EPFD], eax
+    mov     dword [rbx + L_RUNNING], 0
+    mov     qword [rbx + L_NFDS], 0
+    mov     qword [rbx + L_WATCHERS], 0
+    mov     qword [rbx + L_CAP], 0
+    mov     rax, rbx
+
+.end:
+    pop     rbx
+    ret
+
+.fail:
+    mov     rdi, rbx
+    mov     rbx, rax                    ; keep the negative error code
+    call    free wrt ..plt
+    neg     rbx
+    call    __errno_location wrt ..plt
+    mov     [rax], ebx                  ; store error code in errno
+    xor     eax, eax                    ; return NULL
+    pop     rbx
+    ret
+
+ft_loop_add_fd:
+    ; rdi = loop, esi = fd, edx = events, rcx = cb, r8 = arg
+    push    rbx
+    push    r12
+    push    r13
+    push    r14
+    push    r15
+    sub     rsp, 16                     ; struct epoll_event / scratch
+    mov     rbx, rdi                    ; rbx = loop
+    mov     r12d, esi                   ; r12 = fd
+    mov     r13d, edx                   ; r13 = events
+    mov     r14, rcx                    ; r14 = cb
+    mov     r15, r8                     ; r15 = arg
+    test    esi, esi
+    js      .bad_fd
+    test    rcx, rcx
+    jz      .bad_cb                     ; a NULL cb marks a free slot
+
+    cmp     r12, [rbx + L_CAP]
+    jb      .ctl
+
+    ; Grow the fd-indexed table: max(2 * cap, fd + 1, 64) slots
+    mov     rax, [rbx + L_CAP]
+    add     rax, rax
+    lea     rcx, [r12 + 1]
+    cmp     rax, rcx
+    cmovb   rax, rcx
+    mov     ecx, 64
+    cmp     rax, rcx
+    cmovb   rax, rcx
+    mov     [rsp], rax                  ; save new capacity
+    mov     rdi, [rbx + L_WATCHERS]
+    imul    rsi, rax, WATCHER_SIZE
+    call    realloc wrt ..plt
+    test    rax, rax
+    jz      .no_memory
+    mov     [rbx + L_WATCHERS], rax
+
+    ; Clear the new slots
+    mov     rcx, [rbx + L_CAP]
+    imul    rdi, rcx, WATCHER_SIZE
+    add     rdi, rax                    ; &watchers[old cap]
+    mov     rdx, [rsp]
+    mov     [rbx + L_CAP], rdx
+    sub     rdx, rcx
+    imul    rcx, rdx, WATCHER_SIZE
+    xor     eax, eax
+    rep     stosb
+
+.ctl:
+    ; ADD for a new fd, MOD when it is already watched
+    imul    rcx, r12, WATCHER_SIZE
+    add     rcx, [rbx + L_WATCHERS]
+    mov     esi, EPOLL_CTL_ADD
+    mov     eax, EPOLL_CTL_MOD
+    mov     edx, [rcx + W_GEN]
+    cmp     qword [rcx + W_CB], 0
+    cmovne  esi, eax
+    jne     .tag
+    inc     edx                         ; new registration: new generation
+
+.tag:
+    ; The generation tells a reused fd number apart from the one whose
+    ; events may still be queued in the current batch
+    or      r13d, EPOLLET               ; always edge-triggered
+    mov     [rsp], r13d                 ; event.events
+    mov     [rsp + 4], r12d             ; event.data = fd | gen << 32
+    mov     [rsp + 8], edx
+    mov     edi, [rbx + L_EPFD]
+    mov     edx, r12d
+    mov     r10, rsp
+    mov     eax, SYS_EPOLL_CTL
+    syscall
+    test    rax, rax
+    js      .error
+
+    imul    rcx, r12, WATCHER_SIZE
+    add     rcx, [rbx + L_WATCHERS]
+    cmp     qword [rcx + W_CB], 0
+    jne     .store
+    inc     qword [rbx + L_NFDS]        ; newly registered fd
+.store:
+    mov     [rcx + W_CB], r14
+    mov     [rcx + W_ARG], r15
+    mov     eax, [rsp + 8]
+    mov     [rcx + W_GEN], eax
+    xor     eax, eax
+    jmp     .end
+
+.no_memory:
+    mov     eax, -1                     ; errno already set by realloc
+    jmp     .end
+
+.bad_cb:
+    mov     rax, -EINVAL
+    jmp     .error
+
+.bad_fd:
+    mov     rax, -EBADF
+
+.error:
+    add     rsp, 16
+    pop     r15
+    pop     r14
+    pop     r13
+    pop     r12
+    pop     rbx
+    jmp     loop_fail
+
+.end:
+    add     rsp, 16
+    pop     r15
+    pop     r14
+    pop     r13
+    pop     r12
+    pop     rbx
+    ret
+
+ft_loop_del_fd:
+    ; Forget the watcher first so pending events in this batch are skipped
+    mov     eax, esi
+    test    esi, esi
+    js      .ctl
+    cmp     rax, [rdi + L_CAP]
+    jae     .ctl
+    imul    rax, rax, WATCHER_SIZE
+    add     rax, [rdi + L_WATCHERS]
+    cmp     qword [rax + W_CB], 0
+    je      .ctl
+    mov     qword [rax + W_CB], 0
+    mov     qword [rax + W_ARG], 0
+    dec     qword [rdi + L_NFDS]
+
+.ctl:
+    mov     edx, esi                    ; fd
+    mov     edi, [rdi + L_EPFD]
+    mov     esi, EPOLL_CTL_DEL
+    xor     r10d, r10d                  ; no event needed for DEL
+    mov     eax, SYS_EPOLL_CTL
+    syscall
+    test    rax, rax
+    js      loop_fail
+    xor     eax, eax
+    ret
+
+ft_loop_run:
+    ; rdi = loop, esi = timeout in ms (-1 blocks)
+    push    rbx
+    push    r12
+    push    r13
+    push    r14
+    sub     rsp, EVENTS_SIZE + 8        ; event buffer, stack stays aligned
+    mov     rbx, rdi                    ; rbx = loop
+    mov     r12d, esi                   ; r12 = timeout
+    mov     dword [rbx + L_RUNNING], 1
+
+.wait:
+    ; Run until stopped or nothing is left to watch
+    cmp     dword [rbx + L_RUNNING], 0
+    je      .done
+    cmp     qword [rbx + L_NFDS], 0
+    je      .done
+
+    mov     edi, [rbx + L_EPFD]
+    mov     rsi, rsp
+    mov     edx, MAX_EVENTS
+    movsxd  r10, r12d
+    mov     eax, SYS_EPOLL_WAIT
+    syscall
+    test    rax, rax
+    js      .error
+    jz      .done                       ; timed out with nothing ready
+    mov     r13, rax                    ; r13 = ready events
+    xor     r14d, r14d                  ; r14 = index
+
+.dispatch:
+    lea     rax, [r14 + r14 * 2]
+    lea     rax, [rsp + rax * 4]        ; &events[r14] (12 bytes each)
+    mov     esi, [rax]                  ; events
+    mov     edi, [rax + 4]              ; data = fd | gen << 32
+    mov     r8d, [rax + 8]
+    cmp     rdi, [rbx + L_CAP]
+    jae     .next
+    imul    rcx, rdi, WATCHER_SIZE
+    add     rcx, [rbx + L_WATCHERS]     ; re-read: callbacks may grow the table
+    mov     rax, [rcx + W_CB]
+    test    rax, rax
+    jz      .next                       ; removed earlier in this batch
+    cmp     r8d, [rcx + W_GEN]
+    jne     .next                       ; fd number reused since the event was queued
+    mov     rdx, [rcx + W_ARG]
+    call    rax                         ; cb(fd, events, arg)
+
+.next:
+    inc     r14
+    cmp     r14, r13
+    jb      .dispatch
+    jmp     .wait
+
+.error:
+    cmp     rax, -EINTR
+    je      .wait                       ; interrupted by a signal, wait again
+    mov     dword [rbx + L_RUNNING], 0
+    add     rsp, EVENTS_SIZE + 8
+    pop     r14
+    pop     r13
+    pop     r12
+    pop     rbx
+    jmp     loop_fail
+
+.done:
+    mov     dword [rbx + L_RUNNING], 0
+    xor     eax, eax
+    add     rsp, EVENTS_SIZE + 8
+    pop     r14
+    pop     r13
+    pop     r12
+    pop     rbx
+    ret
+
+ft_loop_stop:
+    mov     dword [rdi + L_RUNNING], 0  ; checked before the next wait
+    ret
+
+ft_loop_destroy:
+    push    rbx
+    mov     rbx, rdi
+    mov     edi, [rbx + L_EPFD]
+    mov     eax, SYS_CLOSE
+    syscall
+    mov     rdi, [rbx + L_WATCHERS]
+    call    free wrt ..plt
+    mov     rdi, rbx
+    pop     rbx
+    jmp     free wrt ..plt
+
+
+section .note.GNU-stack noalloc noexec nowrite progbits
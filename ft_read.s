@@ -1,7 +1,15 @@
 global ft_read
+global ft_read_raw
 extern __errno_location
 section .text
 
+ft_read_raw:
+    ; Same system call, but the kernel result is returned as is:
+    ; bytes read, or -errno on failure (errno is left untouched)
+    mov     eax, 0                     ; syscall number for sys_read
+    syscall
+    ret
+
 ft_read:
     ; System call number for read is 0
     mov     rax, 0                     ; syscall number for sys_read
@@ -0,0 +1,322 @@
+global ft_strspn
+global ft_strcspn
+global ft_strtok_r
+global ft_split_init
+global ft_split_next
+
+; Character set layout (first 72 bytes of t_ft_split, see libasm.h)
+;   [0]  lo[16]   bit h of lo[l] set when byte (h << 4 | l) is in the set
+;   [16] hi[16]   hi[h] = 1 << h for h < 8, 0 for h >= 8
+;   [32] map[32]  bitmap of all 256 byte values
+;   [64] int wide set contains bytes >= 0x80: use the bitmap only
+%define SET_LO      0
+%define SET_HI      16
+%define SET_MAP     32
+%define SET_WIDE    64
+%define SET_SIZE    72
+
+; t_ft_split layout
+%define S_CUR       72
+%define S_END       80
+
+section .rodata
+align 16
+nibble_mask:    times 16 db 0x0F
+
+section .text
+
+charset_init:
+    ; rdi = set, rsi = null-terminated list of characters
+    pxor    xmm0, xmm0
+    movdqu  [rdi], xmm0
+    movdqu  [rdi + 16], xmm0
+    movdqu  [rdi + 32], xmm0
+    movdqu  [rdi + 48], xmm0
+    mov     qword [rdi + SET_WIDE], 0
+
+.loop:
+    movzx   eax, byte [rsi]
+    test    eax, eax
+    jz      .end
+    bts     dword [rdi + SET_MAP], eax  ; bitmap always tracks the set
+    cmp     eax, 0x80
+    jae     .wide
+    mov     ecx, eax
+    and     ecx, 15                     ; low nibble
+    mov     edx, eax
+    shr     edx, 4                      ; high nibble (0..7)
+    movzx   r8d, byte [rdi + SET_LO + rcx]
+    bts     r8d, edx
+    mov     [rdi + SET_LO + rcx], r8b   ; lo[l] |= 1 << h
+    xor     r8d, r8d
+    bts     r8d, edx
+    mov     [rdi + SET_HI + rdx], r8b   ; hi[h] = 1 << h
+    inc     rsi
+    jmp     .loop
+
+.wide:
+    mov     dword [rdi + SET_WIDE], 1   ; nibble table cannot represent it
+    inc     rsi
+    jmp     .loop
+
+.end:
+    ret
+
+charset_span:
+    ; rdi = set, rsi = start, rdx = end ((char *)-1 for null-terminated)
+    ; ecx = 1: skip members (strspn), 0: stop at members (strcspn)
+    ; r8d = 1: the terminator also stops the scan
+    ; returns rax = first stop position, at most end
+    cmp     rsi, rdx
+    jae     .at_end
+    cmp     dword [rdi + SET_WIDE], 0
+    jne     .scalar
+
+    movdqu  xmm8, [rdi + SET_LO]
+    movdqu  xmm9, [rdi + SET_HI]
+    movdqa  xmm7, [rel nibble_mask]
+    pxor    xmm6, xmm6
+
+    ; Stop mask = non-members ^ flip, flip = 0xFFFF when stopping at members
+    xor     r9d, r9d
+    mov     eax, 0xFFFF
+    test    ecx, ecx
+    cmovz   r9d, eax
+    neg     r8d
+    and     r8d, r9d                    ; terminator mask (strcspn only)
+
+    ; Aligned blocks never cross a page; ignore the bytes before start
+    mov     r10, rsi
+    and     r10, -16
+    mov     ecx, esi
+    and     ecx, 15
+    movdqa  xmm0, [r10]
+    movdqa  xmm1, xmm0
+    pand    xmm1, xmm7
+    movdqa  xmm2, xmm8
+    pshufb  xmm2, xmm1                  ; lo[byte & 15]
+    movdqa  xmm1, xmm0
+    psrlw   xmm1, 4
+    pand    xmm1, xmm7
+    movdqa  xmm3, xmm9
+    pshufb  xmm3, xmm1                  ; hi[byte >> 4]
+    pand    xmm2, xmm3
+    pcmpeqb xmm2, xmm6                  ; 0xFF for non-members
+    pcmpeqb xmm0, xmm6                  ; 0xFF for terminators
+    pmovmskb eax, xmm2
+    pmovmskb r11d, xmm0
+    xor     eax, r9d
+    and     r11d, r8d
+    or      eax, r11d
+    shr     eax, cl
+    shl     eax, cl
+    jnz     .found
+
+align 16
+.loop:
+    add     r10, 16
+    cmp     r10, rdx
+    jae     .at_end
+    movdqa  xmm0, [r10]
+    movdqa  xmm1, xmm0
+    pand    xmm1, xmm7
+    movdqa  xmm2, xmm8
+    pshufb  xmm2, xmm1
+    movdqa  xmm1, xmm0
+    psrlw   xmm1, 4
+    pand    xmm1, xmm7
+    movdqa  xmm3, xmm9
+    pshufb  xmm3, xmm1
+    pand    xmm2, xmm3
+    pcmpeqb xmm2, xmm6
+    pcmpeqb xmm0, xmm6
+    pmovmskb eax, xmm2
+    pmovmskb r11d, xmm0
+    xor     eax, r9d
+    and     r11d, r8d
+    or      eax, r11d
+    jz      .loop
+
+.found:
+    bsf     eax, eax
+    add     rax, r10
+    cmp     rax, rdx
+    cmova   rax, rdx                    ; stop byte past end: clamp
+    ret
+
+.at_end:
+    mov     rax, rdx
+    ret
+
+.scalar:
+    ; Bitmap lookup one byte at a time
+    mov     rax, rsi
+.s_loop:
+    cmp     rax, rdx
+    jae     .s_end
+    movzx   r9d, byte [rax]
+    bt      dword [rdi + SET_MAP], r9d  ; CF = member
+    setc    r10b
+    xor     r10b, cl                    ; stop when member ^ skip
+    jnz     .s_end
+    test    r9d, r9d
+    jnz     .s_next
+    test    r8d, r8d
+    jnz     .s_end                      ; terminator
+.s_next:
+    inc     rax
+    jmp     .s_loop
+.s_end:
+    ret
+
+ft_strspn:
+    push    rbx
+    sub     rsp, 80                     ; set on the stack, 16-byte aligned
+    mov     rbx, rdi                    ; rbx = s
+    mov     rdi, rsp                    ; rsi = accept
+    call    charset_init
+    mov     rdi, rsp
+    mov     rsi, rbx
+    mov     rdx, -1                     ; null-terminated
+    mov     ecx, 1                      ; skip members
+    mov     r8d, 1
+    call    charset_span
+    sub     rax, rbx                    ; length of the prefix
+    add     rsp, 80
+    pop     rbx
+    ret
+
+ft_strcspn:
+    push    rbx
+    sub     rsp, 80
+    mov     rbx, rdi                    ; rbx = s
+    mov     rdi, rsp                    ; rsi = reject
+    call    charset_init
+    mov     rdi, rsp
+    mov     rsi, rbx
+    mov     rdx, -1
+    xor     ecx, ecx                    ; stop at members
+    mov     r8d, 1                      ; or at the terminator
+    call    charset_span
+    sub     rax, rbx
+    add     rsp, 80
+    pop     rbx
+    ret
+
+ft_strtok_r:
+    ; rdi = str (NULL to continue), rsi = delim, rdx = saveptr
+    push    rbx
+    push    r12
+    push    r13
+    sub     rsp, 80
+    mov     rbx, rdi
+    mov     r12, rsi
+    mov     r13, rdx
+    test    rbx, rbx
+    jnz     .start
+    mov     rbx, [r13]                  ; continue after the previous token
+    xor     eax, eax
+    test    rbx, rbx
+    jz      .end                        ; nothing left: return NULL
+
+.start:
+    mov     rdi, rsp
+    mov     rsi, r12
+    call    charset_init
+
+    ; Skip leading delimiters
+    mov     rdi, rsp
+    mov     rsi, rbx
+    mov     rdx, -1
+    mov     ecx, 1
+    mov     r8d, 1
+    call    charset_span
+    mov     rbx, rax
+    cmp     byte [rbx], 0
+    je      .no_token
+
+    ; Find the end of the token and terminate it in place
+    mov     rdi, rsp
+    mov     rsi, rbx
+    mov     rdx, -1
+    xor     ecx, ecx
+    mov     r8d, 1
+    call    charset_span
+    cmp     byte [rax], 0
+    je      .last
+    mov     byte [rax], 0
+    inc     rax
+.last:
+    mov     [r13], rax                  ; resume here next time
+    mov     rax, rbx                    ; return the token
+    jmp     .end
+
+.no_token:
+    mov     [r13], rbx
+    xor     eax, eax                    ; return NULL
+
+.end:
+    add     rsp, 80
+    pop     r13
+    pop     r12
+    pop     rbx
+    ret
+
+ft_split_init:
+    ; rdi = it, rsi = buf, rdx = len, rcx = delim
+    push    rdi
+    push    rsi
+    push    rdx
+    mov     rsi, rcx
+    call    charset_init
+    pop     rdx
+    pop     rsi
+    pop     rdi
+    mov     [rdi + S_CUR], rsi
+    add     rsi, rdx
+    mov     [rdi + S_END], rsi
+    ret
+
+ft_split_next:
+    ; rdi = it, rsi = &token, rdx = &len -> 1 with a token, 0 when done
+    push    rbx
+    push    r12
+    push    r13
+    mov     rbx, rdi
+    mov     r12, rsi
+    mov     r13, rdx
+
+    ; Skip delimiters; the buffer is bounded, never null-terminated
+    mov     rsi, [rbx + S_CUR]
+    mov     rdx, [rbx + S_END]
+    mov     ecx, 1
+    xor     r8d, r8d
+    call    charset_span
+    cmp     rax, [rbx + S_END]
+    jae     .done
+    mov     [r12], rax                  ; token start
+
+    mov     rdi, rbx
+    mov     rsi, rax
+    mov     rdx, [rbx + S_END]
+    xor     ecx, ecx
+    xor     r8d, r8d
+    call    charset_span
+    mov     [rbx + S_CUR], rax
+    sub     rax, [r12]
+    mov     [r13], rax                  ; token length
+    mov     eax, 1
+    jmp     .end
+
+.done:
+    mov     [rbx + S_CUR], rax
+    xor     eax, eax
+
+.end:
+    pop     r13
+    pop     r12
+    pop     rbx
+    ret
+
+
+section .note.GNU-stack noalloc noexec nowrite progbits
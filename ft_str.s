@@ -0,0 +1,231 @@
+global ft_str_init
+global ft_str_reserve
+global ft_str_append_n
+global ft_str_append
+global ft_str_cstr
+global ft_str_cmp
+global ft_str_hash
+global ft_str_free
+extern malloc
+extern realloc
+extern free
+extern ft_strlen
+
+; t_ft_str layout (see libasm.h)
+;   [0]  char sso[24] / char *heap
+;   [24] size_t len
+;   [32] size_t cap   (cap <= SSO_CAP means the bytes live inline)
+%define STR_LEN     24
+%define STR_CAP     32
+%define SSO_CAP     23
+
+section .text
+
+ft_str_init:
+    mov     qword [rdi + STR_LEN], 0    ; empty string
+    mov     qword [rdi + STR_CAP], SSO_CAP ; start with the inline buffer
+    mov     byte [rdi], 0               ; null terminate it
+    ret
+
+ft_str_cstr:
+    ; Inline bytes while cap fits in the struct, heap pointer otherwise
+    mov     rax, rdi                    ; assume inline storage
+    cmp     qword [rdi + STR_CAP], SSO_CAP
+    cmova   rax, [rdi]                  ; heap storage: load the pointer
+    ret
+
+ft_str_reserve:
+    ; rdi = str, rsi = capacity needed (excluding the terminator)
+    mov     rax, [rdi + STR_CAP]
+    cmp     rsi, rax                    ; already big enough?
+    ja      .grow
+    xor     eax, eax                    ; return 0
+    ret
+
+.grow:
+    ; Geometric growth: new_cap = max(2 * cap, needed)
+    add     rax, rax
+    cmp     rax, rsi
+    cmovb   rax, rsi
+
+    push    rbx
+    push    r12
+    sub     rsp, 8                      ; keep the stack 16-byte aligned
+    mov     rbx, rdi                    ; rbx = str
+    mov     r12, rax                    ; r12 = new capacity
+    lea     rsi, [rax + 1]              ; room for the terminator
+
+    cmp     qword [rbx + STR_CAP], SSO_CAP
+    ja      .realloc                    ; already on the heap
+
+    ; Leaving the inline buffer: allocate and move the bytes out
+    mov     rdi, rsi
+    call    malloc wrt ..plt
+    test    rax, rax
+    jz      .fail
+    mov     rdi, rax                    ; destination = new heap buffer
+    mov     rsi, rbx                    ; source = inline buffer
+    mov     rcx, [rbx + STR_LEN]
+    inc     rcx                         ; copy the terminator too
+    rep     movsb
+    mov     [rbx], rax                  ; heap pointer replaces inline bytes
+    jmp     .done
+
+.realloc:
+    mov     rdi, [rbx]                  ; current heap buffer
+    call    realloc wrt ..plt           ; realloc keeps the contents
+    test    rax, rax
+    jz      .fail
+    mov     [rbx], rax
+
+.done:
+    mov     [rbx + STR_CAP], r12        ; commit the new capacity
+    xor     eax, eax                    ; return 0
+    add     rsp, 8
+    pop     r12
+    pop     rbx
+    ret
+
+.fail:
+    ; malloc/realloc already set errno to ENOMEM, string is untouched
+    mov     eax, -1
+    add     rsp, 8
+    pop     r12
+    pop     rbx
+    ret
+
+ft_str_append_n:
+    ; rdi = str, rsi = src, rdx = n
+    push    rbx
+    push    r12
+    push    r13
+    push    r14
+    sub     rsp, 8                      ; keep the stack 16-byte aligned
+    mov     rbx, rdi                    ; rbx = str
+    mov     r12, rsi                    ; r12 = src
+    mov     r13, rdx                    ; r13 = n
+
+    ; src may point into our own bytes (self-append), and reserve may move
+    ; them: remember its offset so it can be rebased afterwards
+    mov     rax, rdi
+    cmp     qword [rdi + STR_CAP], SSO_CAP
+    cmova   rax, [rdi]                  ; rax = data
+    mov     r14, rsi
+    sub     r14, rax                    ; r14 = src - data
+    cmp     r14, [rdi + STR_LEN]
+    jbe     .reserve                    ; inside [data, data + len]
+    mov     r14, -1                     ; outside: src stays valid
+
+.reserve:
+    mov     rsi, [rdi + STR_LEN]
+    add     rsi, rdx                    ; capacity needed = len + n
+    call    ft_str_reserve
+    test    eax, eax
+    jnz     .end                        ; propagate -1
+
+    ; Destination = data + len
+    mov     rdi, rbx
+    cmp     qword [rbx + STR_CAP], SSO_CAP
+    cmova   rdi, [rbx]
+    cmp     r14, -1
+    je      .copy
+    lea     r12, [rdi + r14]            ; src rebased onto the current buffer
+
+.copy:
+    mov     rax, [rbx + STR_LEN]
+    add     rdi, rax
+    add     rax, r13
+    mov     [rbx + STR_LEN], rax        ; store the new length
+
+    mov     rsi, r12
+    mov     rcx, r13
+    rep     movsb                       ; copy n bytes
+    mov     byte [rdi], 0               ; null terminate
+    xor     eax, eax                    ; return 0
+
+.end:
+    add     rsp, 8
+    pop     r14
+    pop     r13
+    pop     r12
+    pop     rbx
+    ret
+
+ft_str_append:
+    ; Measure src once with ft_strlen, then append by length
+    push    rdi
+    push    rsi
+    sub     rsp, 8                      ; keep the stack 16-byte aligned
+    mov     rdi, rsi
+    call    ft_strlen
+    mov     rdx, rax                    ; n = ft_strlen(src)
+    add     rsp, 8
+    pop     rsi
+    pop     rdi
+    jmp     ft_str_append_n
+
+ft_str_cmp:
+    ; Compare min(len1, len2) bytes, then the lengths: embedded NULs count,
+    ; so equal strings are exactly the ones ft_str_hash hashes the same
+    mov     r8, [rdi + STR_LEN]         ; r8 = len1
+    mov     rdx, [rsi + STR_LEN]        ; rdx = len2
+    cmp     qword [rdi + STR_CAP], SSO_CAP
+    cmova   rdi, [rdi]
+    cmp     qword [rsi + STR_CAP], SSO_CAP
+    cmova   rsi, [rsi]
+    mov     rcx, r8
+    cmp     rdx, rcx
+    cmovb   rcx, rdx                    ; rcx = min(len1, len2)
+    test    rcx, rcx
+    jz      .lengths                    ; cmpsb leaves flags alone when rcx is 0
+    repe    cmpsb
+    jne     .differ
+
+.lengths:
+    ; Common prefix is equal: the shorter string sorts first
+    xor     eax, eax
+    cmp     r8, rdx
+    seta    al                          ; 1 if len1 > len2
+    sbb     eax, 0                      ; -1 if len1 < len2
+    ret
+
+.differ:
+    movzx   eax, byte [rdi - 1]         ; cmpsb already stepped past the byte
+    movzx   ecx, byte [rsi - 1]
+    sub     eax, ecx                    ; unsigned byte difference
+    ret
+
+ft_str_hash:
+    ; 64-bit FNV-1a over the stored length (no terminator scan)
+    mov     rcx, [rdi + STR_LEN]
+    cmp     qword [rdi + STR_CAP], SSO_CAP
+    cmova   rdi, [rdi]
+    mov     rax, 0xcbf29ce484222325     ; FNV offset basis
+    mov     r8, 0x100000001b3           ; FNV prime
+    test    rcx, rcx
+    jz      .end
+
+.loop:
+    movzx   edx, byte [rdi]
+    xor     rax, rdx                    ; hash ^= byte
+    imul    rax, r8                     ; hash *= prime
+    inc     rdi
+    dec     rcx
+    jnz     .loop
+
+.end:
+    ret
+
+ft_str_free:
+    cmp     qword [rdi + STR_CAP], SSO_CAP
+    jbe     .reset                      ; nothing on the heap
+    push    rdi
+    mov     rdi, [rdi]
+    call    free wrt ..plt
+    pop     rdi
+
+.reset:
+    jmp     ft_str_init                 ; leave an empty, reusable string
+
+
+section .note.GNU-stack noalloc noexec nowrite progbits
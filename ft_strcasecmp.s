@@ -0,0 +1,214 @@
+global ft_strcasecmp
+global ft_strncasecmp
+
+section .rodata
+align 16
+upper_bias:     times 16 db 0x3F        ; 'A'..'Z' + 0x3F -> -128..-103 (signed)
+alpha_limit:    times 16 db 0x9A        ; -102: first value past the letter range
+case_bit:       times 16 db 0x20        ; 'a' - 'A'
+
+section .text
+
+ft_strcasecmp:
+    ; Constants stay in registers for the whole scan
+    movdqa  xmm5, [rel upper_bias]
+    movdqa  xmm6, [rel alpha_limit]
+    movdqa  xmm7, [rel case_bit]
+    pxor    xmm4, xmm4                  ; zero vector for terminator detection
+
+align 16
+.loop:
+    ; A 16-byte load is only safe if it cannot cross into the next page
+    mov     eax, edi
+    and     eax, 4095
+    cmp     eax, 4080
+    ja      .byte_step
+    mov     eax, esi
+    and     eax, 4095
+    cmp     eax, 4080
+    ja      .byte_step
+
+    movdqu  xmm0, [rdi]                 ; 16 bytes of s1
+    movdqu  xmm1, [rsi]                 ; 16 bytes of s2
+
+    ; Lowercase s1: range compare selects 'A'..'Z', OR in the case bit
+    movdqa  xmm2, xmm0
+    paddb   xmm2, xmm5
+    movdqa  xmm3, xmm6
+    pcmpgtb xmm3, xmm2
+    pand    xmm3, xmm7
+    por     xmm0, xmm3
+
+    ; Lowercase s2 the same way
+    movdqa  xmm2, xmm1
+    paddb   xmm2, xmm5
+    movdqa  xmm3, xmm6
+    pcmpgtb xmm3, xmm2
+    pand    xmm3, xmm7
+    por     xmm1, xmm3
+
+    ; Stop at the first differing byte or at the terminator of s1
+    movdqa  xmm2, xmm0
+    pcmpeqb xmm2, xmm4                  ; terminator in s1
+    pcmpeqb xmm1, xmm0                  ; equal bytes
+    pmovmskb eax, xmm1
+    pmovmskb ecx, xmm2
+    xor     eax, 0xFFFF                 ; differing bytes
+    or      eax, ecx
+    jnz     .found
+    add     rdi, 16
+    add     rsi, 16
+    jmp     .loop
+
+.found:
+    bsf     eax, eax                    ; index of the first stop byte
+    add     rdi, rax
+    add     rsi, rax
+    movzx   ecx, byte [rdi]
+    movzx   edx, byte [rsi]
+    jmp     .difference
+
+.byte_step:
+    ; Near a page end: advance one byte until both loads are safe again
+    movzx   ecx, byte [rdi]
+    movzx   edx, byte [rsi]
+    lea     r8d, [rcx - 'A']
+    cmp     r8d, 26
+    sbb     r9d, r9d                    ; -1 if uppercase
+    and     r9d, 0x20
+    or      ecx, r9d
+    lea     r8d, [rdx - 'A']
+    cmp     r8d, 26
+    sbb     r9d, r9d
+    and     r9d, 0x20
+    or      edx, r9d
+    cmp     ecx, edx
+    jne     .result
+    test    ecx, ecx
+    jz      .result                     ; both terminated: equal
+    inc     rdi
+    inc     rsi
+    jmp     .loop
+
+.difference:
+    ; Lowercase the two stop bytes, then return their unsigned difference
+    lea     r8d, [rcx - 'A']
+    cmp     r8d, 26
+    sbb     r9d, r9d
+    and     r9d, 0x20
+    or      ecx, r9d
+    lea     r8d, [rdx - 'A']
+    cmp     r8d, 26
+    sbb     r9d, r9d
+    and     r9d, 0x20
+    or      edx, r9d
+
+.result:
+    mov     eax, ecx
+    sub     eax, edx                    ; tolower(*s1) - tolower(*s2)
+    ret
+
+ft_strncasecmp:
+    ; Same scan as ft_strcasecmp, bounded by n (rdx)
+    test    rdx, rdx
+    jz      .equal
+    movdqa  xmm5, [rel upper_bias]
+    movdqa  xmm6, [rel alpha_limit]
+    movdqa  xmm7, [rel case_bit]
+    pxor    xmm4, xmm4
+
+align 16
+.loop:
+    mov     eax, edi
+    and     eax, 4095
+    cmp     eax, 4080
+    ja      .byte_step
+    mov     eax, esi
+    and     eax, 4095
+    cmp     eax, 4080
+    ja      .byte_step
+
+    movdqu  xmm0, [rdi]
+    movdqu  xmm1, [rsi]
+
+    movdqa  xmm2, xmm0
+    paddb   xmm2, xmm5
+    movdqa  xmm3, xmm6
+    pcmpgtb xmm3, xmm2
+    pand    xmm3, xmm7
+    por     xmm0, xmm3
+
+    movdqa  xmm2, xmm1
+    paddb   xmm2, xmm5
+    movdqa  xmm3, xmm6
+    pcmpgtb xmm3, xmm2
+    pand    xmm3, xmm7
+    por     xmm1, xmm3
+
+    movdqa  xmm2, xmm0
+    pcmpeqb xmm2, xmm4
+    pcmpeqb xmm1, xmm0
+    pmovmskb eax, xmm1
+    pmovmskb ecx, xmm2
+    xor     eax, 0xFFFF
+    or      eax, ecx
+    jnz     .found
+    sub     rdx, 16
+    jbe     .equal                      ; n bytes compared
+    add     rdi, 16
+    add     rsi, 16
+    jmp     .loop
+
+.found:
+    bsf     eax, eax
+    cmp     rax, rdx
+    jae     .equal                      ; stop byte lies beyond n
+    add     rdi, rax
+    add     rsi, rax
+    movzx   ecx, byte [rdi]
+    movzx   edx, byte [rsi]
+    lea     r8d, [rcx - 'A']
+    cmp     r8d, 26
+    sbb     r9d, r9d
+    and     r9d, 0x20
+    or      ecx, r9d
+    lea     r8d, [rdx - 'A']
+    cmp     r8d, 26
+    sbb     r9d, r9d
+    and     r9d, 0x20
+    or      edx, r9d
+    mov     eax, ecx
+    sub     eax, edx
+    ret
+
+.byte_step:
+    movzx   ecx, byte [rdi]
+    movzx   r10d, byte [rsi]
+    lea     r8d, [rcx - 'A']
+    cmp     r8d, 26
+    sbb     r9d, r9d
+    and     r9d, 0x20
+    or      ecx, r9d
+    lea     r8d, [r10 - 'A']
+    cmp     r8d, 26
+    sbb     r9d, r9d
+    and     r9d, 0x20
+    or      r10d, r9d
+    mov     eax, ecx
+    sub     eax, r10d
+    jnz     .end                        ; bytes differ
+    test    ecx, ecx
+    jz      .end                        ; both terminated: equal
+    inc     rdi
+    inc     rsi
+    dec     rdx
+    jnz     .loop
+
+.equal:
+    xor     eax, eax
+
+.end:
+    ret
+
+
+section .note.GNU-stack noalloc noexec nowrite progbits
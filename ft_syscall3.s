@@ -0,0 +1,14 @@
+global ft_syscall3
+section .text
+
+ft_syscall3:
+    ; Shift the C arguments into the system call registers
+    mov     rax, rdi                    ; syscall number
+    mov     rdi, rsi                    ; first argument
+    mov     rsi, rdx                    ; second argument
+    mov     rdx, rcx                    ; third argument
+    syscall                             ; invoke system call
+    ret                                 ; raw result, -errno on failure
+
+
+section .note.GNU-stack noalloc noexec nowrite progbits
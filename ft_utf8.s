@@ -0,0 +1,184 @@
+global ft_utf8_validate
+global ft_utf8_strlen
+extern ft_strlen
+
+; Error bits for the nibble lookups: a byte pair is invalid when the three
+; tables (high/low nibble of the previous byte, high nibble of the current
+; byte) agree on at least one bit.
+;   0x01 TOO_SHORT   lead byte or ASCII where a continuation is required
+;   0x02 TOO_LONG    ASCII followed by a continuation
+;   0x04 OVERLONG_3  E0 followed by 80..9F
+;   0x08 TOO_LARGE   F4 followed by 90..BF, or F5..FF
+;   0x10 SURROGATE   ED followed by A0..BF
+;   0x20 OVERLONG_2  C0/C1 lead
+;   0x40 OVERLONG_4  F0 followed by 80..8F (also TOO_LARGE_1000: F5.. + 80..8F)
+;   0x80 TWO_CONTS   continuation after continuation (checked against length)
+
+section .rodata
+align 16
+byte1_high:     db 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02
+                db 0x80, 0x80, 0x80, 0x80, 0x21, 0x01, 0x15, 0x49
+byte1_low:      db 0xE7, 0xA3, 0x83, 0x83, 0x8B, 0xCB, 0xCB, 0xCB
+                db 0xCB, 0xCB, 0xCB, 0xCB, 0xCB, 0xDB, 0xCB, 0xCB
+byte2_high:     db 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01
+                db 0xE6, 0xAE, 0xBA, 0xBA, 0x01, 0x01, 0x01, 0x01
+incomplete_max: db 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+                db 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xEF, 0xDF, 0xBF
+nibble_mask:    times 16 db 0x0F
+third_min:      times 16 db 0xDF        ; only E0..FF survive prev2 - 0xDF
+fourth_min:     times 16 db 0xEF        ; only F0..FF survive prev3 - 0xEF
+high_bit:       times 16 db 0x80
+cont_limit:     times 16 db 0xBF        ; -65: continuation bytes are <= this
+
+section .text
+
+utf8_block:
+    ; xmm0 = 16 input bytes
+    ; xmm13 = error accumulator, xmm14 = incomplete tail of the previous
+    ; block, xmm15 = previous block (all three persist across calls)
+    pmovmskb eax, xmm0
+    test    eax, eax
+    jnz     .multibyte
+
+    ; ASCII only: valid unless the previous block ended mid-sequence
+    por     xmm13, xmm14
+    pxor    xmm14, xmm14
+    movdqa  xmm15, xmm0
+    ret
+
+.multibyte:
+    ; Previous 1, 2 and 3 bytes for every position
+    movdqa  xmm1, xmm0
+    palignr xmm1, xmm15, 15             ; prev1
+    movdqa  xmm2, xmm0
+    palignr xmm2, xmm15, 14             ; prev2
+    movdqa  xmm3, xmm0
+    palignr xmm3, xmm15, 13             ; prev3
+    movdqa  xmm7, [rel nibble_mask]
+
+    ; Special cases: byte1_high[prev1 >> 4] & byte1_low[prev1 & 15] & byte2_high[input >> 4]
+    movdqa  xmm4, xmm1
+    psrlw   xmm4, 4
+    pand    xmm4, xmm7
+    movdqa  xmm5, [rel byte1_high]
+    pshufb  xmm5, xmm4
+    movdqa  xmm4, xmm1
+    pand    xmm4, xmm7
+    movdqa  xmm6, [rel byte1_low]
+    pshufb  xmm6, xmm4
+    pand    xmm5, xmm6
+    movdqa  xmm4, xmm0
+    psrlw   xmm4, 4
+    pand    xmm4, xmm7
+    movdqa  xmm6, [rel byte2_high]
+    pshufb  xmm6, xmm4
+    pand    xmm5, xmm6
+
+    ; Third/fourth bytes of 3/4-byte sequences must be continuations,
+    ; and only those may carry TWO_CONTS
+    psubusb xmm2, [rel third_min]
+    psubusb xmm3, [rel fourth_min]
+    por     xmm2, xmm3
+    pxor    xmm4, xmm4
+    pcmpgtb xmm2, xmm4                  ; 0xFF where a continuation is expected
+    pand    xmm2, [rel high_bit]
+    pxor    xmm2, xmm5
+    por     xmm13, xmm2
+
+    ; Remember whether the block ends inside a sequence
+    movdqa  xmm14, xmm0
+    psubusb xmm14, [rel incomplete_max]
+    movdqa  xmm15, xmm0
+    ret
+
+ft_utf8_validate:
+    ; rdi = buf, rsi = len -> 1 if valid UTF-8, 0 otherwise
+    pxor    xmm13, xmm13
+    pxor    xmm14, xmm14
+    pxor    xmm15, xmm15
+
+.loop:
+    cmp     rsi, 16
+    jb      .tail
+    movdqu  xmm0, [rdi]
+    call    utf8_block
+    add     rdi, 16
+    sub     rsi, 16
+    jmp     .loop
+
+.tail:
+    ; Zero-pad the last 0..15 bytes; the padding also exposes any
+    ; sequence truncated at the end of the buffer
+    sub     rsp, 24                     ; 16-byte aligned scratch block
+    pxor    xmm0, xmm0
+    movdqa  [rsp], xmm0
+    mov     rcx, rsi
+    mov     rsi, rdi
+    mov     rdi, rsp
+    rep     movsb
+    movdqa  xmm0, [rsp]
+    call    utf8_block
+    add     rsp, 24
+
+    ; Valid when no error bit was ever set
+    pxor    xmm0, xmm0
+    pcmpeqb xmm13, xmm0
+    pmovmskb ecx, xmm13
+    xor     eax, eax
+    cmp     ecx, 0xFFFF
+    sete    al
+    ret
+
+ft_utf8_strlen:
+    ; Code points = bytes that are not continuations (10xxxxxx)
+    push    rdi
+    call    ft_strlen
+    pop     rsi                         ; rsi = str
+    mov     rcx, rax                    ; rcx = bytes left
+    xor     eax, eax                    ; rax = count
+    movdqa  xmm7, [rel cont_limit]
+    pxor    xmm6, xmm6
+
+.outer:
+    cmp     rcx, 16
+    jb      .tail
+    pxor    xmm1, xmm1                  ; per-byte counters
+    mov     edx, 255                    ; flush before a byte counter can overflow
+
+.inner:
+    movdqu  xmm0, [rsi]
+    pcmpgtb xmm0, xmm7                  ; 0xFF for ASCII and lead bytes
+    psubb   xmm1, xmm0                  ; +1 each
+    add     rsi, 16
+    sub     rcx, 16
+    cmp     rcx, 16
+    jb      .flush
+    dec     edx
+    jnz     .inner
+
+.flush:
+    psadbw  xmm1, xmm6                  ; horizontal sums into two qwords
+    movq    rdx, xmm1
+    add     rax, rdx
+    psrldq  xmm1, 8
+    movq    rdx, xmm1
+    add     rax, rdx
+    jmp     .outer
+
+.tail:
+    test    rcx, rcx
+    jz      .end
+    movzx   edx, byte [rsi]
+    and     edx, 0xC0
+    cmp     edx, 0x80                   ; continuation byte?
+    setne   dl
+    add     rax, rdx
+    inc     rsi
+    dec     rcx
+    jmp     .tail
+
+.end:
+    ret
+
+
+section .note.GNU-stack noalloc noexec nowrite progbits
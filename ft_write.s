@@ -1,7 +1,15 @@
 global ft_write
+global ft_write_raw
 extern __errno_location
 section .text
 
+ft_write_raw:
+    ; Same system call, but the kernel result is returned as is:
+    ; bytes written, or -errno on failure (errno is left untouched)
+    mov     eax, 1                     ; syscall number for sys_write
+    syscall
+    ret
+
 ft_write:
     ; System call number for write is 1
     mov     rax, 1                     ; syscall number for sys_write
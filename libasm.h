@@ -2,9 +2,11 @@
 #define LIBASM_H
 
 #include <stddef.h>  // for size_t
+#include <stdint.h>  // for uint32_t
 #include <sys/types.h>  // for ssize_t
 #include <errno.h>  // for errno
 #include <stdlib.h>  // for malloc, free
+#include <sys/uio.h>  // for struct iovec
 
 size_t ft_strlen(const char *str);
 char *ft_strcpy(char *dest, const char *src);
@@ -13,4 +15,114 @@ ssize_t ft_write(int fd, const void *buf, size_t count);
 ssize_t ft_read(int fd, void *buf, size_t count);
 char *ft_strdup(const char *str);
 
+// Raw system call results: -errno on failure, errno is never touched
+ssize_t ft_read_raw(int fd, void *buf, size_t count);
+ssize_t ft_write_raw(int fd, const void *buf, size_t count);
+long ft_syscall3(long number, long arg1, long arg2, long arg3);
+
+// ASCII-only case handling (no locale), SSE2 16-byte blocks
+int ft_strcasecmp(const char *s1, const char *s2);
+int ft_strncasecmp(const char *s1, const char *s2, size_t n);
+char *ft_tolower_inplace(char *str);
+char *ft_toupper_inplace(char *str);
+
+// UTF-8: validation (SSSE3) rejects overlong forms, surrogates, code points
+// above U+10FFFF and truncated sequences; strlen counts code points (SSE2)
+int ft_utf8_validate(const char *buf, size_t len);
+size_t ft_utf8_strlen(const char *str);
+
+// Delimiter sets are classified 16 bytes at a time with a pshufb nibble
+// table (SSSE3); sets containing bytes >= 0x80 fall back to the bitmap
+typedef struct s_ft_split {
+    unsigned char lo[16];               // bit h of lo[l]: byte (h << 4 | l) is a delimiter
+    unsigned char hi[16];               // hi[h] = 1 << h for ASCII high nibbles
+    unsigned char map[32];              // bitmap of all 256 byte values
+    int wide;                           // set has bytes >= 0x80: bitmap only
+    const char *cur;                    // next byte to scan
+    const char *end;                    // end of the buffer
+} t_ft_split;
+
+size_t ft_strspn(const char *s, const char *accept);
+size_t ft_strcspn(const char *s, const char *reject);
+char *ft_strtok_r(char *str, const char *delim, char **saveptr);
+void ft_split_init(t_ft_split *it, const char *buf, size_t len, const char *delim);
+int ft_split_next(t_ft_split *it, const char **token, size_t *len);
+
+// Small-string-optimized string: up to FT_STR_SSO_CAP bytes live inline,
+// longer strings move to the heap and grow geometrically.
+#define FT_STR_SSO_CAP 23
+
+typedef struct s_ft_str {
+    union {
+        char *heap;                     // heap buffer when cap > FT_STR_SSO_CAP
+        char sso[FT_STR_SSO_CAP + 1];   // inline buffer otherwise
+    };
+    size_t len;                         // bytes stored, excluding the terminator
+    size_t cap;                         // usable bytes, excluding the terminator
+} t_ft_str;
+
+void ft_str_init(t_ft_str *str);
+int ft_str_reserve(t_ft_str *str, size_t cap);
+int ft_str_append_n(t_ft_str *str, const char *src, size_t n);
+int ft_str_append(t_ft_str *str, const char *src);
+const char *ft_str_cstr(const t_ft_str *str);
+int ft_str_cmp(const t_ft_str *s1, const t_ft_str *s2);
+size_t ft_str_hash(const t_ft_str *str);
+void ft_str_free(t_ft_str *str);
+
+// Chunked output builder: small fragments are copied into 4 KB chunks,
+// large ones are referenced in place, everything leaves in one writev.
+#define FT_BUILDER_CHUNK 4096
+#define FT_BUILDER_COPY_MAX 512        // ft_builder_append_ref copies below this
+
+typedef struct s_ft_chunk {
+    struct s_ft_chunk *next;
+    size_t used;
+    char data[FT_BUILDER_CHUNK];
+} t_ft_chunk;
+
+typedef struct s_ft_builder {
+    struct iovec *iov;                  // pending fragments, in output order
+    size_t iovcnt;
+    size_t iovcap;
+    t_ft_chunk *chunks;                 // copy storage, newest first
+    size_t total;                       // bytes pending
+} t_ft_builder;
+
+void ft_builder_init(t_ft_builder *b);
+int ft_builder_append(t_ft_builder *b, const void *buf, size_t len);
+int ft_builder_append_ref(t_ft_builder *b, const void *buf, size_t len);
+ssize_t ft_builder_flush(t_ft_builder *b, int fd);
+void ft_builder_free(t_ft_builder *b);
+
+// Edge-triggered event loop on raw epoll syscalls. Callbacks must drain
+// their fd until EAGAIN; remove an fd with ft_loop_del_fd before closing it.
+#define FT_LOOP_READ  0x001             // EPOLLIN
+#define FT_LOOP_WRITE 0x004             // EPOLLOUT
+#define FT_LOOP_ERROR 0x008             // EPOLLERR
+#define FT_LOOP_HUP   0x010             // EPOLLHUP
+
+typedef void (*t_ft_io_cb)(int fd, uint32_t events, void *arg);
+
+typedef struct s_ft_watcher {
+    t_ft_io_cb cb;                      // NULL when the slot is free
+    void *arg;
+    uint32_t gen;                       // bumped on every registration, tags events
+} t_ft_watcher;
+
+typedef struct s_ft_loop {
+    int epfd;
+    int running;
+    size_t nfds;                        // registered fds
+    t_ft_watcher *watchers;             // indexed by fd
+    size_t cap;
+} t_ft_loop;
+
+t_ft_loop *ft_loop_create(void);
+int ft_loop_add_fd(t_ft_loop *loop, int fd, uint32_t events, t_ft_io_cb cb, void *arg);
+int ft_loop_del_fd(t_ft_loop *loop, int fd);
+int ft_loop_run(t_ft_loop *loop, int timeout_ms);
+void ft_loop_stop(t_ft_loop *loop);
+void ft_loop_destroy(t_ft_loop *loop);
+
 #endif
@@ -5,6 +5,10 @@
 #include <time.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/resource.h>
+#include <sys/mman.h>
+#include <strings.h>
 
 #define ITERATIONS 10000000
 
@@ -279,6 +283,19 @@ void test_strcmp_functionality() {
     printf("   libc vs C:         " GREEN "%.2fx faster" RESET "\n", my_time / libc_time);
 }
 
+int my_tolower(int c) {
+    return (c >= 'A' && c <= 'Z') ? c + 32 : c;
+}
+
+int my_strncasecmp(const char *s1, const char *s2, size_t n) {
+    while (n && *s1 && my_tolower((unsigned char)*s1) == my_tolower((unsigned char)*s2)) {
+        s1++;
+        s2++;
+        n--;
+    }
+    return n ? my_tolower((unsigned char)*s1) - my_tolower((unsigned char)*s2) : 0;
+}
+
 ssize_t my_write(int fd, const void *buf, size_t count) {
     return write(fd, buf, count);
 }
@@ -771,15 +788,1138 @@ void test_strdup_functionality() {
     }
 }
 
+void test_str_functionality() {
+    print_section("FT_STR (SSO STRING) FUNCTIONALITY TEST");
+    
+    printf(BOLD "🧪 CORRECTNESS TESTS:" RESET "\n\n");
+    
+    int passed = 0;
+    int num_tests = 0;
+    t_ft_str s;
+    
+    // Empty string starts inline
+    ft_str_init(&s);
+    int ok = s.len == 0 && s.cap == FT_STR_SSO_CAP && ft_str_cstr(&s) == s.sso && strcmp(ft_str_cstr(&s), "") == 0;
+    printf("   Empty init:          %s\n", ok ? GREEN "✅ PASS" RESET : RED "❌ FAIL" RESET);
+    passed += ok; num_tests++;
+    
+    // Short appends stay in the inline buffer
+    ft_str_append(&s, "Content-");
+    ft_str_append(&s, "Length");
+    ok = s.len == 14 && ft_str_cstr(&s) == s.sso && strcmp(ft_str_cstr(&s), "Content-Length") == 0;
+    printf("   Inline append:       \"" CYAN "%s" RESET "\" %s\n", ft_str_cstr(&s), ok ? GREEN "✅ PASS" RESET : RED "❌ FAIL" RESET);
+    passed += ok; num_tests++;
+    
+    // Exactly FT_STR_SSO_CAP bytes still fits inline
+    ft_str_append(&s, ": 1234567");
+    ok = s.len == FT_STR_SSO_CAP && ft_str_cstr(&s) == s.sso && strcmp(ft_str_cstr(&s), "Content-Length: 1234567") == 0;
+    printf("   Full inline (%zu B):  %s\n", s.len, ok ? GREEN "✅ PASS" RESET : RED "❌ FAIL" RESET);
+    passed += ok; num_tests++;
+    
+    // One more byte moves the string to the heap
+    ft_str_append(&s, "8");
+    ok = s.len == FT_STR_SSO_CAP + 1 && s.cap > FT_STR_SSO_CAP && ft_str_cstr(&s) != s.sso
+         && strcmp(ft_str_cstr(&s), "Content-Length: 12345678") == 0;
+    printf("   Spill to heap:       \"" CYAN "%s" RESET "\" (cap: %zu) %s\n", ft_str_cstr(&s), s.cap, ok ? GREEN "✅ PASS" RESET : RED "❌ FAIL" RESET);
+    passed += ok; num_tests++;
+    ft_str_free(&s);
+    
+    // Many appends grow geometrically and match a plain C buffer
+    char expected[4096] = "";
+    size_t reallocs = 0, last_cap = 0;
+    ft_str_init(&s);
+    for (int i = 0; i < 200; i++) {
+        ft_str_append(&s, "chunk-");
+        strcat(expected, "chunk-");
+        if (s.cap != last_cap) { reallocs++; last_cap = s.cap; }
+    }
+    ok = s.len == strlen(expected) && strcmp(ft_str_cstr(&s), expected) == 0 && reallocs < 12;
+    printf("   Geometric growth:    %zu bytes, %zu capacity changes %s\n", s.len, reallocs, ok ? GREEN "✅ PASS" RESET : RED "❌ FAIL" RESET);
+    passed += ok; num_tests++;
+    ft_str_free(&s);
+    ok = s.len == 0 && s.cap == FT_STR_SSO_CAP && ft_str_cstr(&s) == s.sso;
+    printf("   Free resets inline:  %s\n", ok ? GREEN "✅ PASS" RESET : RED "❌ FAIL" RESET);
+    passed += ok; num_tests++;
+    
+    // append_n copies exactly n bytes
+    ft_str_init(&s);
+    ft_str_append_n(&s, "GET /index.html HTTP/1.1", 3);
+    ok = s.len == 3 && strcmp(ft_str_cstr(&s), "GET") == 0;
+    printf("   append_n:            \"" CYAN "%s" RESET "\" %s\n", ft_str_cstr(&s), ok ? GREEN "✅ PASS" RESET : RED "❌ FAIL" RESET);
+    passed += ok; num_tests++;
+    ft_str_free(&s);
+
+    // Self-append: the source lives in the buffer that grows under it
+    ft_str_init(&s);
+    ft_str_append(&s, "0123456789ab");
+    ft_str_append(&s, ft_str_cstr(&s));
+    ok = s.len == 24 && ft_str_cstr(&s) != s.sso && strcmp(ft_str_cstr(&s), "0123456789ab0123456789ab") == 0;
+    printf("   Self-append spill:   \"" CYAN "%s" RESET "\" %s\n", ft_str_cstr(&s), ok ? GREEN "✅ PASS" RESET : RED "❌ FAIL" RESET);
+    passed += ok; num_tests++;
+    strcpy(expected, ft_str_cstr(&s));
+    for (int i = 0; i < 6; i++) {
+        ft_str_append_n(&s, ft_str_cstr(&s) + 2, s.len - 2);
+        size_t n = strlen(expected);
+        memmove(expected + n, expected + 2, n - 2);
+        expected[2 * n - 2] = '\0';
+    }
+    ok = s.len == strlen(expected) && strcmp(ft_str_cstr(&s), expected) == 0;
+    printf("   Self-append heap:    %zu bytes %s\n", s.len, ok ? GREEN "✅ PASS" RESET : RED "❌ FAIL" RESET);
+    passed += ok; num_tests++;
+    ft_str_free(&s);
+
+    // Compare and hash, inline against heap
+    const char *pairs[][2] = {
+        {"host", "host"},
+        {"host", "hostname"},
+        {"This string is long enough for the heap", "This string is long enough for the heap"},
+        {"short", "This string is long enough for the heap"},
+        {"ABC", "abc"}
+    };
+    for (size_t i = 0; i < sizeof(pairs) / sizeof(pairs[0]); i++) {
+        t_ft_str a, b;
+        ft_str_init(&a);
+        ft_str_init(&b);
+        ft_str_append(&a, pairs[i][0]);
+        ft_str_append(&b, pairs[i][1]);
+        int ft_result = ft_str_cmp(&a, &b);
+        int libc_result = strcmp(pairs[i][0], pairs[i][1]);
+        int same_sign = (ft_result > 0) == (libc_result > 0) && (ft_result < 0) == (libc_result < 0);
+        int hash_ok = (ft_str_hash(&a) == ft_str_hash(&b)) == (libc_result == 0);
+        ok = same_sign && hash_ok;
+        printf("   cmp/hash %-8.8s vs %-8.8s: cmp=%d hash %s %s\n", pairs[i][0], pairs[i][1], ft_result,
+               ft_str_hash(&a) == ft_str_hash(&b) ? "equal" : "differ", ok ? GREEN "✅ PASS" RESET : RED "❌ FAIL" RESET);
+        passed += ok; num_tests++;
+        ft_str_free(&a);
+        ft_str_free(&b);
+    }
+
+    // Embedded NULs: cmp uses the stored length, so it agrees with hash
+    const struct { const char *a; size_t a_len; const char *b; size_t b_len; int sign; } binary[] = {
+        {"k\0x", 3, "k\0y", 3, -1},
+        {"k\0x", 3, "k\0x", 3, 0},
+        {"k", 1, "k\0", 2, -1},
+        {"key\0\xff", 5, "key\0\x01", 5, 1}
+    };
+    for (size_t i = 0; i < sizeof(binary) / sizeof(binary[0]); i++) {
+        t_ft_str a, b;
+        ft_str_init(&a);
+        ft_str_init(&b);
+        ft_str_append_n(&a, binary[i].a, binary[i].a_len);
+        ft_str_append_n(&b, binary[i].b, binary[i].b_len);
+        int ft_result = ft_str_cmp(&a, &b);
+        int sign = (ft_result > 0) - (ft_result < 0);
+        int hash_equal = ft_str_hash(&a) == ft_str_hash(&b);
+        ok = sign == binary[i].sign && hash_equal == (ft_result == 0) && sign == -((ft_str_cmp(&b, &a) > 0) - (ft_str_cmp(&b, &a) < 0));
+        printf("   cmp/hash NUL case %zu:  cmp=%d hash %s %s\n", i, ft_result,
+               hash_equal ? "equal" : "differ", ok ? GREEN "✅ PASS" RESET : RED "❌ FAIL" RESET);
+        passed += ok; num_tests++;
+        ft_str_free(&a);
+        ft_str_free(&b);
+    }
+
+    printf("\n" BOLD "📊 TEST RESULTS: " GREEN "%d/%d PASSED" RESET "\n\n", passed, num_tests);
+
+    // Performance test: short strings never touch malloc
+    printf(BOLD "⚡ PERFORMANCE BENCHMARK:" RESET "\n");
+    const int STR_ITERATIONS = 1000000;
+    const char header[] __attribute__((aligned(16))) = "keep-alive";
+    printf("Building " MAGENTA "%d" RESET " copies of \"%s\"...\n\n", STR_ITERATIONS, header);
+    
+    clock_t start, end;
+    size_t sink = 0;
+    
+    start = clock();
+    for (int i = 0; i < STR_ITERATIONS; i++) {
+        t_ft_str tmp;
+        ft_str_init(&tmp);
+        ft_str_append(&tmp, header);
+        sink += tmp.len;
+        ft_str_free(&tmp);
+    }
+    end = clock();
+    double str_time = (double)(end - start) / CLOCKS_PER_SEC;
+    printf("🚀 ft_str (inline):    " CYAN "%.6f seconds" RESET "\n", str_time);
+    
+    start = clock();
+    for (int i = 0; i < STR_ITERATIONS; i++) {
+        char *tmp = ft_strdup(header);
+        sink += ft_strlen(tmp);
+        free(tmp);
+    }
+    end = clock();
+    double dup_time = (double)(end - start) / CLOCKS_PER_SEC;
+    printf("🔄 ft_strdup + strlen: " CYAN "%.6f seconds" RESET " (checksum %zu)\n\n", dup_time, sink);
+    
+    printf(BOLD "📊 PERFORMANCE COMPARISON:" RESET "\n");
+    printf("   ft_str vs ft_strdup: " YELLOW "%.2fx %s" RESET "\n",
+           str_time > dup_time ? str_time / dup_time : dup_time / str_time,
+           str_time > dup_time ? "slower" : "faster");
+}
+
+void test_builder_functionality() {
+    print_section("FT_BUILDER (CHUNKED OUTPUT) TEST");
+    
+    printf(BOLD "🧪 CORRECTNESS TESTS:" RESET "\n\n");
+    
+    int passed = 0;
+    int num_tests = 0;
+    
+    // Mixed small copies and large references, flushed to a temporary file
+    const size_t big_len = 64 * 1024;
+    char *big = malloc(big_len);
+    char *expected = malloc(4 * 1024 * 1024);
+    char *readback = malloc(4 * 1024 * 1024);
+    for (size_t i = 0; i < big_len; i++) big[i] = 'a' + (i % 26);
+    
+    t_ft_builder b;
+    ft_builder_init(&b);
+    size_t exp_len = 0;
+    for (int i = 0; i < 20000; i++) {
+        char line[32];
+        int n = snprintf(line, sizeof(line), "line %d\n", i);
+        ft_builder_append(&b, line, n);
+        memcpy(expected + exp_len, line, n);
+        exp_len += n;
+        if (i % 1000 == 0) {
+            ft_builder_append_ref(&b, big, big_len);
+            memcpy(expected + exp_len, big, big_len);
+            exp_len += big_len;
+        }
+    }
+    int ok = b.total == exp_len;
+    printf("   Pending bytes:       %zu in %zu iovecs %s\n", b.total, b.iovcnt, ok ? GREEN "✅ PASS" RESET : RED "❌ FAIL" RESET);
+    passed += ok; num_tests++;
+    
+    FILE *tmp = tmpfile();
+    ssize_t written = ft_builder_flush(&b, fileno(tmp));
+    rewind(tmp);
+    size_t got = fread(readback, 1, 4 * 1024 * 1024, tmp);
+    fclose(tmp);
+    ok = written == (ssize_t)exp_len && got == exp_len && memcmp(readback, expected, exp_len) == 0;
+    printf("   Flush to file:       %zd bytes, content %s %s\n", written, got == exp_len && memcmp(readback, expected, exp_len) == 0 ? "matches" : "differs",
+           ok ? GREEN "✅ PASS" RESET : RED "❌ FAIL" RESET);
+    passed += ok; num_tests++;
+    
+    ok = b.total == 0 && b.iovcnt == 0 && b.chunks == NULL;
+    printf("   Reset after flush:   %s\n", ok ? GREEN "✅ PASS" RESET : RED "❌ FAIL" RESET);
+    passed += ok; num_tests++;
+    
+    // Short fragments go into the chunk, not into their own iovec
+    ft_builder_append_ref(&b, "tiny", 4);
+    ft_builder_append_ref(&b, "-ref", 4);
+    ok = b.iovcnt == 1 && b.total == 8 && b.chunks != NULL;
+    printf("   Small refs copied:   %zu iovec(s) %s\n", b.iovcnt, ok ? GREEN "✅ PASS" RESET : RED "❌ FAIL" RESET);
+    passed += ok; num_tests++;
+    
+    // Errors surface through errno like ft_write
+    errno = 0;
+    written = ft_builder_flush(&b, -1);
+    ok = written == -1 && errno == EBADF && b.total == 8;
+    printf("   Bad fd:              ret=%zd errno=%d (%s) %s\n", written, errno, strerror(errno), ok ? GREEN "✅ PASS" RESET : RED "❌ FAIL" RESET);
+    passed += ok; num_tests++;
+    ft_builder_free(&b);
+    
+    // Non-blocking pipe: EAGAIN mid-flush, then retry until everything is out
+    int fds[2];
+    pipe(fds);
+    fcntl(fds[0], F_SETFL, O_NONBLOCK);
+    fcntl(fds[1], F_SETFL, O_NONBLOCK);
+    ft_builder_init(&b);
+    exp_len = 0;
+    for (int i = 0; i < 4; i++) {
+        ft_builder_append_ref(&b, big, big_len);
+        ft_builder_append(&b, "|", 1);
+        memcpy(expected + exp_len, big, big_len);
+        exp_len += big_len;
+        expected[exp_len++] = '|';
+    }
+    size_t drained = 0;
+    int retries = 0;
+    while (ft_builder_flush(&b, fds[1]) < 0 && errno == EAGAIN) {
+        retries++;
+        ssize_t r;
+        while ((r = read(fds[0], readback + drained, 65536)) > 0) drained += r;
+    }
+    close(fds[1]);
+    ssize_t r;
+    while ((r = read(fds[0], readback + drained, 65536)) > 0) drained += r;
+    close(fds[0]);
+    ok = retries > 0 && drained == exp_len && memcmp(readback, expected, exp_len) == 0;
+    printf("   EAGAIN retry:        %d retries, %zu bytes intact %s\n", retries, drained, ok ? GREEN "✅ PASS" RESET : RED "❌ FAIL" RESET);
+    passed += ok; num_tests++;
+    ft_builder_free(&b);
+    
+    printf("\n" BOLD "📊 TEST RESULTS: " GREEN "%d/%d PASSED" RESET "\n\n", passed, num_tests);
+    
+    // Performance test: assemble a multi-MB response and emit it to /dev/null
+    printf(BOLD "⚡ PERFORMANCE BENCHMARK:" RESET "\n");
+    const int ROUNDS = 50;
+    int devnull = open("/dev/null", O_WRONLY);
+    printf("Emitting " MAGENTA "%d" RESET " responses of ~%zu KB (small headers + 64 KB bodies)...\n\n",
+           ROUNDS, (size_t)(64 * (big_len + 14)) / 1024);
+    
+    clock_t start, end;
+    
+    start = clock();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int i = 0; i < 64; i++) {
+            ft_builder_append(&b, "X-Chunk: part\n", 14);
+            ft_builder_append_ref(&b, big, big_len);
+        }
+        ft_builder_flush(&b, devnull);
+    }
+    end = clock();
+    double builder_time = (double)(end - start) / CLOCKS_PER_SEC;
+    printf("🚀 ft_builder + writev: " CYAN "%.6f seconds" RESET "\n", builder_time);
+    
+    char *flat = malloc(64 * (big_len + 15));
+    big[big_len - 1] = '\0';
+    start = clock();
+    for (int round = 0; round < ROUNDS; round++) {
+        char *p = flat;
+        for (int i = 0; i < 64; i++) {
+            ft_strcpy(p, "X-Chunk: part\n");
+            p += 14;
+            ft_strcpy(p, big);
+            p += big_len - 1;
+        }
+        ft_write(devnull, flat, p - flat);
+    }
+    end = clock();
+    double flat_time = (double)(end - start) / CLOCKS_PER_SEC;
+    printf("🔄 ft_strcpy + ft_write: " CYAN "%.6f seconds" RESET "\n\n", flat_time);
+    close(devnull);
+    
+    printf(BOLD "📊 PERFORMANCE COMPARISON:" RESET "\n");
+    printf("   builder vs strcpy:  " YELLOW "%.2fx %s" RESET "\n",
+           builder_time > flat_time ? builder_time / flat_time : flat_time / builder_time,
+           builder_time > flat_time ? "slower" : "faster");
+    
+    ft_builder_free(&b);
+    free(flat);
+    free(big);
+    free(expected);
+    free(readback);
+}
+
+typedef struct s_loop_probe {
+    t_ft_loop *loop;
+    int calls;
+    uint32_t events;
+    char buf[64];
+    ssize_t got;
+} t_loop_probe;
+
+void loop_probe_cb(int fd, uint32_t events, void *arg) {
+    t_loop_probe *probe = arg;
+    probe->calls++;
+    probe->events = events;
+    probe->got = ft_read(fd, probe->buf, sizeof(probe->buf) - 1);
+    ft_loop_stop(probe->loop);
+}
+
+typedef struct s_loop_reuse {
+    t_ft_loop *loop;
+    int fds[2];                 // read ends watched in the same batch
+    int spare;                  // read end moved onto the other fd number
+    int first_calls;
+    int reused_calls;
+} t_loop_reuse;
+
+void loop_reused_cb(int fd, uint32_t events, void *arg) {
+    (void)events;
+    t_loop_reuse *reuse = arg;
+    char buf[16];
+    reuse->reused_calls++;
+    while (ft_read_raw(fd, buf, sizeof(buf)) > 0)
+        ;
+    ft_loop_stop(reuse->loop);
+}
+
+void loop_reuse_cb(int fd, uint32_t events, void *arg) {
+    (void)events;
+    t_loop_reuse *reuse = arg;
+    char buf[16];
+    reuse->first_calls++;
+    while (ft_read_raw(fd, buf, sizeof(buf)) > 0)
+        ;
+    // The other fd still has an event queued in this batch: close it and
+    // hand its number to a different pipe before that event is dispatched
+    int other = fd == reuse->fds[0] ? reuse->fds[1] : reuse->fds[0];
+    ft_loop_del_fd(reuse->loop, other);
+    close(other);
+    dup2(reuse->spare, other);
+    ft_loop_add_fd(reuse->loop, other, FT_LOOP_READ, loop_reused_cb, reuse);
+    ft_loop_stop(reuse->loop);
+}
+
+#define ECHO_MSG_SIZE 64
+
+typedef struct s_echo_bench {
+    t_ft_loop *loop;
+    int active;                 // clients still running
+    size_t bytes;               // bytes echoed back to clients
+    size_t round_trips;
+    double latency_sum;
+    double latency_max;
+} t_echo_bench;
+
+typedef struct s_echo_client {
+    t_echo_bench *bench;
+    int rounds_left;
+    size_t received;
+    struct timespec sent_at;
+} t_echo_client;
+
+double elapsed_seconds(const struct timespec *from, const struct timespec *to) {
+    return (to->tv_sec - from->tv_sec) + (to->tv_nsec - from->tv_nsec) / 1e9;
+}
+
+void echo_server_cb(int fd, uint32_t events, void *arg) {
+    (void)events;
+    (void)arg;
+    char buf[4096];
+    ssize_t n;
+    // Edge-triggered: drain until -EAGAIN, errno is never touched
+    while ((n = ft_read_raw(fd, buf, sizeof(buf))) > 0)
+        ft_write_raw(fd, buf, n);
+}
+
+void echo_client_cb(int fd, uint32_t events, void *arg) {
+    (void)events;
+    t_echo_client *client = arg;
+    t_echo_bench *bench = client->bench;
+    char buf[4096];
+    ssize_t n;
+    while ((n = ft_read_raw(fd, buf, sizeof(buf))) > 0) {
+        client->received += n;
+        bench->bytes += n;
+    }
+    while (client->received >= ECHO_MSG_SIZE) {
+        client->received -= ECHO_MSG_SIZE;
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        double latency = elapsed_seconds(&client->sent_at, &now);
+        bench->latency_sum += latency;
+        if (latency > bench->latency_max) bench->latency_max = latency;
+        bench->round_trips++;
+        if (--client->rounds_left > 0) {
+            memset(buf, 'e', ECHO_MSG_SIZE);
+            client->sent_at = now;
+            ft_write_raw(fd, buf, ECHO_MSG_SIZE);
+        } else if (--bench->active == 0) {
+            ft_loop_stop(bench->loop);
+        }
+    }
+}
+
+void test_loop_functionality() {
+    print_section("FT_LOOP (EPOLL EVENT LOOP) TEST");
+    
+    printf(BOLD "🧪 CORRECTNESS TESTS:" RESET "\n\n");
+    
+    int passed = 0;
+    int num_tests = 0;
+    
+    t_ft_loop *loop = ft_loop_create();
+    int ok = loop != NULL && loop->epfd >= 0 && loop->nfds == 0;
+    printf("   Create:              epfd=%d %s\n", loop ? loop->epfd : -1, ok ? GREEN "✅ PASS" RESET : RED "❌ FAIL" RESET);
+    passed += ok; num_tests++;
+    
+    // Readiness callback on a non-blocking pipe
+    int fds[2];
+    pipe(fds);
+    fcntl(fds[0], F_SETFL, O_NONBLOCK);
+    t_loop_probe probe = {loop, 0, 0, {0}, 0};
+    ok = ft_loop_add_fd(loop, fds[0], FT_LOOP_READ, loop_probe_cb, &probe) == 0 && loop->nfds == 1;
+    printf("   Add pipe fd:         %s\n", ok ? GREEN "✅ PASS" RESET : RED "❌ FAIL" RESET);
+    passed += ok; num_tests++;
+    
+    ft_write(fds[1], "ping", 4);
+    int ret = ft_loop_run(loop, 1000);
+    probe.buf[probe.got > 0 ? probe.got : 0] = '\0';
+    ok = ret == 0 && probe.calls == 1 && (probe.events & FT_LOOP_READ) && strcmp(probe.buf, "ping") == 0;
+    printf("   Read callback:       calls=%d data=\"" CYAN "%s" RESET "\" %s\n", probe.calls, probe.buf, ok ? GREEN "✅ PASS" RESET : RED "❌ FAIL" RESET);
+    passed += ok; num_tests++;
+    
+    // Timeout with nothing ready returns without calling back
+    ret = ft_loop_run(loop, 10);
+    ok = ret == 0 && probe.calls == 1;
+    printf("   Idle timeout:        %s\n", ok ? GREEN "✅ PASS" RESET : RED "❌ FAIL" RESET);
+    passed += ok; num_tests++;
+    
+    // Re-adding an fd modifies it instead of failing with EEXIST
+    ok = ft_loop_add_fd(loop, fds[0], FT_LOOP_READ, loop_probe_cb, &probe) == 0 && loop->nfds == 1;
+    printf("   Re-add modifies:     nfds=%zu %s\n", loop->nfds, ok ? GREEN "✅ PASS" RESET : RED "❌ FAIL" RESET);
+    passed += ok; num_tests++;
+    
+    // Removing the last fd makes run return immediately
+    ok = ft_loop_del_fd(loop, fds[0]) == 0 && loop->nfds == 0 && ft_loop_run(loop, -1) == 0;
+    printf("   Delete + empty run:  %s\n", ok ? GREEN "✅ PASS" RESET : RED "❌ FAIL" RESET);
+    passed += ok; num_tests++;
+    close(fds[0]);
+    close(fds[1]);
+    
+    // Errors surface through errno like ft_read
+    errno = 0;
+    ret = ft_loop_add_fd(loop, -1, FT_LOOP_READ, loop_probe_cb, &probe);
+    ok = ret == -1 && errno == EBADF;
+    printf("   Bad fd:              ret=%d errno=%d (%s) %s\n", ret, errno, strerror(errno), ok ? GREEN "✅ PASS" RESET : RED "❌ FAIL" RESET);
+    passed += ok; num_tests++;
+
+    // A NULL callback would look like a free slot: rejected, nothing registered
+    pipe(fds);
+    errno = 0;
+    ret = ft_loop_add_fd(loop, fds[0], FT_LOOP_READ, NULL, &probe);
+    ok = ret == -1 && errno == EINVAL && loop->nfds == 0
+         && ft_loop_add_fd(loop, fds[0], FT_LOOP_READ, loop_probe_cb, &probe) == 0 && loop->nfds == 1;
+    printf("   NULL callback:       ret=%d errno=%d (%s) %s\n", ret, errno, strerror(errno), ok ? GREEN "✅ PASS" RESET : RED "❌ FAIL" RESET);
+    passed += ok; num_tests++;
+    ft_loop_del_fd(loop, fds[0]);
+    close(fds[0]);
+    close(fds[1]);
+
+    // An fd number reused inside one batch must not receive the old fd's event
+    int a[2], b[2], spare[2];
+    pipe(a);
+    pipe(b);
+    pipe(spare);
+    fcntl(a[0], F_SETFL, O_NONBLOCK);
+    fcntl(b[0], F_SETFL, O_NONBLOCK);
+    fcntl(spare[0], F_SETFL, O_NONBLOCK);
+    t_loop_reuse reuse = {loop, {a[0], b[0]}, spare[0], 0, 0};
+    ft_loop_add_fd(loop, a[0], FT_LOOP_READ, loop_reuse_cb, &reuse);
+    ft_loop_add_fd(loop, b[0], FT_LOOP_READ, loop_reuse_cb, &reuse);
+    ft_write(a[1], "a", 1);
+    ft_write(b[1], "b", 1);
+    ret = ft_loop_run(loop, 1000);
+    ok = ret == 0 && reuse.first_calls == 1 && reuse.reused_calls == 0 && loop->nfds == 2;
+    printf("   Reused fd in batch:  first=%d reused=%d %s\n", reuse.first_calls, reuse.reused_calls, ok ? GREEN "✅ PASS" RESET : RED "❌ FAIL" RESET);
+    passed += ok; num_tests++;
+
+    // The new watcher on that fd number still gets its own events
+    ft_write(spare[1], "s", 1);
+    ret = ft_loop_run(loop, 1000);
+    ok = ret == 0 && reuse.first_calls == 1 && reuse.reused_calls == 1;
+    printf("   Reused fd later:     reused=%d %s\n", reuse.reused_calls, ok ? GREEN "✅ PASS" RESET : RED "❌ FAIL" RESET);
+    passed += ok; num_tests++;
+    ft_loop_del_fd(loop, a[0]);
+    ft_loop_del_fd(loop, b[0]);
+    close(a[0]);
+    close(a[1]);
+    close(b[0]);
+    close(b[1]);
+    close(spare[0]);
+    close(spare[1]);
+    ft_loop_destroy(loop);
+    
+    printf("\n" BOLD "📊 TEST RESULTS: " GREEN "%d/%d PASSED" RESET "\n\n", passed, num_tests);
+    
+    // Performance test: socketpair echo across thousands of fds
+    printf(BOLD "⚡ ECHO BENCHMARK:" RESET "\n");
+    struct rlimit rl;
+    getrlimit(RLIMIT_NOFILE, &rl);
+    rl.rlim_cur = rl.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &rl);
+    getrlimit(RLIMIT_NOFILE, &rl);
+    int pairs = 2048;
+    if ((rlim_t)pairs * 2 + 64 > rl.rlim_cur) pairs = (rl.rlim_cur - 64) / 2;
+    const int ROUNDS = 50;
+    
+    t_echo_bench bench = {ft_loop_create(), pairs, 0, 0, 0, 0};
+    t_echo_client *clients = calloc(pairs, sizeof(t_echo_client));
+    int (*socks)[2] = calloc(pairs, sizeof(*socks));
+    for (int i = 0; i < pairs; i++) {
+        socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, socks[i]);
+        clients[i].bench = &bench;
+        clients[i].rounds_left = ROUNDS;
+        ft_loop_add_fd(bench.loop, socks[i][0], FT_LOOP_READ, echo_server_cb, NULL);
+        ft_loop_add_fd(bench.loop, socks[i][1], FT_LOOP_READ, echo_client_cb, &clients[i]);
+    }
+    printf("Echoing " MAGENTA "%d" RESET " x %d-byte messages over " MAGENTA "%d" RESET " socketpairs (%zu fds)...\n\n",
+           ROUNDS, ECHO_MSG_SIZE, pairs, bench.loop->nfds);
+    
+    struct timespec start, end;
+    char msg[ECHO_MSG_SIZE];
+    memset(msg, 'e', sizeof(msg));
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < pairs; i++) {
+        clients[i].sent_at = start;
+        ft_write(socks[i][1], msg, sizeof(msg));
+    }
+    ft_loop_run(bench.loop, 1000);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double total = elapsed_seconds(&start, &end);
+    
+    ok = bench.active == 0 && bench.round_trips == (size_t)pairs * ROUNDS;
+    printf("🚀 Round trips:  " CYAN "%zu" RESET " in " CYAN "%.6f seconds" RESET " %s\n", bench.round_trips, total,
+           ok ? GREEN "✅ COMPLETE" RESET : RED "❌ INCOMPLETE" RESET);
+    printf("   Throughput:   " YELLOW "%.0f msgs/s, %.2f MB/s" RESET "\n",
+           bench.round_trips / total, bench.bytes / total / (1024 * 1024));
+    printf("   Latency:      " YELLOW "avg %.2f us, max %.2f us" RESET "\n",
+           bench.round_trips ? bench.latency_sum / bench.round_trips * 1e6 : 0.0, bench.latency_max * 1e6);
+    
+    for (int i = 0; i < pairs; i++) {
+        ft_loop_del_fd(bench.loop, socks[i][0]);
+        ft_loop_del_fd(bench.loop, socks[i][1]);
+        close(socks[i][0]);
+        close(socks[i][1]);
+    }
+    ft_loop_destroy(bench.loop);
+    free(socks);
+    free(clients);
+}
+
+void test_raw_io_functionality() {
+    print_section("RAW READ/WRITE (ERRNO-FREE) TEST");
+    
+    printf(BOLD "🧪 CORRECTNESS TESTS:" RESET "\n\n");
+    
+    int passed = 0;
+    int num_tests = 0;
+    int fds[2];
+    pipe(fds);
+    fcntl(fds[0], F_SETFL, O_NONBLOCK);
+    char buf[32] = {0};
+    
+    ssize_t ret = ft_write_raw(fds[1], "raw bytes", 9);
+    int ok = ret == 9;
+    printf("   ft_write_raw:        ret=%zd %s\n", ret, ok ? GREEN "✅ PASS" RESET : RED "❌ FAIL" RESET);
+    passed += ok; num_tests++;
+    
+    ret = ft_read_raw(fds[0], buf, sizeof(buf) - 1);
+    ok = ret == 9 && strcmp(buf, "raw bytes") == 0;
+    printf("   ft_read_raw:         ret=%zd data=\"" CYAN "%s" RESET "\" %s\n", ret, buf, ok ? GREEN "✅ PASS" RESET : RED "❌ FAIL" RESET);
+    passed += ok; num_tests++;
+    
+    // Failures return -errno and leave errno alone
+    errno = 0;
+    ret = ft_read_raw(fds[0], buf, sizeof(buf));
+    ok = ret == -EAGAIN && errno == 0;
+    printf("   Empty pipe:          ret=%zd (-EAGAIN=%d) errno=%d %s\n", ret, -EAGAIN, errno, ok ? GREEN "✅ PASS" RESET : RED "❌ FAIL" RESET);
+    passed += ok; num_tests++;
+    
+    ret = ft_write_raw(-1, "x", 1);
+    ok = ret == -EBADF && errno == 0;
+    printf("   Bad fd:              ret=%zd (-EBADF=%d) errno=%d %s\n", ret, -EBADF, errno, ok ? GREEN "✅ PASS" RESET : RED "❌ FAIL" RESET);
+    passed += ok; num_tests++;
+    
+    // The errno variants still behave as before
+    ret = ft_read(fds[0], buf, sizeof(buf));
+    ok = ret == -1 && errno == EAGAIN;
+    printf("   ft_read unchanged:   ret=%zd errno=%d (%s) %s\n", ret, errno, strerror(errno), ok ? GREEN "✅ PASS" RESET : RED "❌ FAIL" RESET);
+    passed += ok; num_tests++;
+    
+    // Generic entry point: getpid (39) and write (1)
+    long pid = ft_syscall3(39, 0, 0, 0);
+    ok = pid == getpid() && ft_syscall3(1, fds[1], (long)"abc", 3) == 3 && ft_read_raw(fds[0], buf, 3) == 3;
+    printf("   ft_syscall3:         getpid=%ld %s\n", pid, ok ? GREEN "✅ PASS" RESET : RED "❌ FAIL" RESET);
+    passed += ok; num_tests++;
+    
+    printf("\n" BOLD "📊 TEST RESULTS: " GREEN "%d/%d PASSED" RESET "\n\n", passed, num_tests);
+    
+    // Performance test: polling an empty non-blocking pipe
+    printf(BOLD "⚡ PERFORMANCE BENCHMARK:" RESET "\n");
+    const int RAW_ITERATIONS = 1000000;
+    printf("Polling an empty non-blocking pipe " MAGENTA "%d" RESET " times...\n\n", RAW_ITERATIONS);
+    
+    clock_t start, end;
+    int eagain = 0;
+    
+    start = clock();
+    for (int i = 0; i < RAW_ITERATIONS; i++) {
+        if (ft_read(fds[0], buf, sizeof(buf)) < 0 && errno == EAGAIN) eagain++;
+    }
+    end = clock();
+    double errno_time = (double)(end - start) / CLOCKS_PER_SEC;
+    printf("🔄 ft_read + errno:  " CYAN "%.6f seconds" RESET "\n", errno_time);
+    
+    start = clock();
+    for (int i = 0; i < RAW_ITERATIONS; i++) {
+        if (ft_read_raw(fds[0], buf, sizeof(buf)) == -EAGAIN) eagain++;
+    }
+    end = clock();
+    double raw_time = (double)(end - start) / CLOCKS_PER_SEC;
+    printf("🚀 ft_read_raw:      " CYAN "%.6f seconds" RESET " (%d EAGAIN)\n\n", raw_time, eagain);
+    
+    printf(BOLD "📊 PERFORMANCE COMPARISON:" RESET "\n");
+    printf("   raw vs errno:      " YELLOW "%.2fx %s" RESET " (dominated by the syscall itself)\n",
+           raw_time > errno_time ? raw_time / errno_time : errno_time / raw_time,
+           raw_time > errno_time ? "slower" : "faster");
+    
+    close(fds[0]);
+    close(fds[1]);
+}
+
+void test_case_functionality() {
+    print_section("CASE-INSENSITIVE FUNCTIONALITY TEST");
+    
+    struct {
+        const char *s1;
+        const char *s2;
+        size_t n;
+        const char *description;
+    } test_cases[] = {
+        {"Content-Length", "content-length", 100, "Header names, mixed case"},
+        {"HOST", "host", 100, "All upper vs all lower"},
+        {"Accept-Encoding", "Accept-Charset", 100, "Different headers"},
+        {"keep-alive", "Keep-Alive, Upgrade", 100, "Prefix"},
+        {"", "", 100, "Both empty strings"},
+        {"abc", "", 100, "Second string empty"},
+        {"[\\]^_`", "{|}~", 100, "Punctuation around letters"},
+        {"@AZ[", "`az{", 100, "Range edges"},
+        {"caf\xc3\xa9", "CAF\xc3\x89", 100, "Non-ASCII bytes untouched"},
+        {"Transfer-Encoding: chunked", "TRANSFER-ENCODING: CHUNKED", 100, "Longer than 16 bytes"},
+        {"X-Forwarded-For: 10.0.0.1", "x-forwarded-for: 10.0.0.2", 100, "Differs after 16 bytes"},
+        {"X-Forwarded-For: 10.0.0.1", "x-forwarded-for: 10.0.0.2", 24, "Same, limited by n"},
+        {"abcdef", "ABCxyz", 3, "Limited prefix"},
+        {"abc", "xyz", 0, "n == 0"}
+    };
+    
+    int num_tests = sizeof(test_cases) / sizeof(test_cases[0]);
+    
+    printf(BOLD "🧪 CORRECTNESS TESTS:" RESET "\n\n");
+    
+    int passed = 0;
+    for (int i = 0; i < num_tests; i++) {
+        int ft_result = ft_strncasecmp(test_cases[i].s1, test_cases[i].s2, test_cases[i].n);
+        int my_result = my_strncasecmp(test_cases[i].s1, test_cases[i].s2, test_cases[i].n);
+        int libc_result = strncasecmp(test_cases[i].s1, test_cases[i].s2, test_cases[i].n);
+        int ok = ft_result == my_result && (ft_result > 0) == (libc_result > 0) && (ft_result < 0) == (libc_result < 0);
+        if (test_cases[i].n == 100) {
+            int full = ft_strcasecmp(test_cases[i].s1, test_cases[i].s2);
+            ok = ok && full == ft_result;
+        }
+        printf("   %-28s ft: %4d | libc: %4d %s\n", test_cases[i].description, ft_result, libc_result,
+               ok ? GREEN "✅" RESET : RED "❌" RESET);
+        if (ok) passed++;
+    }
+    
+    // In-place conversion, bytes after the terminator must stay untouched
+    char buf[64] __attribute__((aligned(16)));
+    memset(buf, 'Q', sizeof(buf));
+    strcpy(buf + 3, "Mixed-Case Header Value: \xc3\x89t\xc3\xa9 [42]");
+    char *ret = ft_tolower_inplace(buf + 3);
+    int ok = ret == buf + 3 && strcmp(buf + 3, "mixed-case header value: \xc3\x89t\xc3\xa9 [42]") == 0 && buf[63] == 'Q' && buf[2] == 'Q';
+    printf("   %-28s \"" CYAN "%s" RESET "\" %s\n", "ft_tolower_inplace", buf + 3, ok ? GREEN "✅" RESET : RED "❌" RESET);
+    passed += ok; num_tests++;
+    
+    ret = ft_toupper_inplace(buf + 3);
+    ok = ret == buf + 3 && strcmp(buf + 3, "MIXED-CASE HEADER VALUE: \xc3\x89T\xc3\xa9 [42]") == 0 && buf[63] == 'Q' && buf[2] == 'Q';
+    printf("   %-28s \"" CYAN "%s" RESET "\" %s\n", "ft_toupper_inplace", buf + 3, ok ? GREEN "✅" RESET : RED "❌" RESET);
+    passed += ok; num_tests++;
+    
+    // Strings ending right before an unmapped page
+    char *pages = mmap(NULL, 8192, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    mprotect(pages + 4096, 4096, PROT_NONE);
+    char *edge1 = pages + 4096 - 6;
+    char *edge2 = pages + 4096 - 20;
+    strcpy(edge1, "HeLLo");
+    strcpy(edge2, "hello");
+    ok = ft_strcasecmp(edge1, edge2) == 0 && ft_strncasecmp(edge2, edge1, 1000) == 0;
+    ft_toupper_inplace(edge1);
+    ok = ok && strcmp(edge1, "HELLO") == 0;
+    printf("   %-28s %s\n", "Page boundary", ok ? GREEN "✅" RESET : RED "❌" RESET);
+    passed += ok; num_tests++;
+    munmap(pages, 8192);
+    
+    // Randomized comparison against the reference at every alignment
+    const char alphabet[] = "aAbBzZ@[`{-0";
+    int random_ok = 1;
+    srand(42);
+    for (int i = 0; i < 20000 && random_ok; i++) {
+        char a[80], b[80];
+        int len = rand() % 64;
+        char *pb = b + rand() % 8;
+        for (int j = 0; j < len; j++) {
+            a[j] = alphabet[rand() % 12];
+            // Mostly the same letter in either case, sometimes a different byte
+            pb[j] = (rand() % 8) ? (rand() % 2 ? my_tolower(a[j]) : a[j]) : alphabet[rand() % 12];
+        }
+        a[len] = pb[len] = '\0';
+        size_t n = rand() % 80;
+        if (ft_strcasecmp(a, pb) != my_strncasecmp(a, pb, (size_t)-1)
+            || ft_strncasecmp(a, pb, n) != my_strncasecmp(a, pb, n))
+            random_ok = 0;
+    }
+    printf("   %-28s %s\n", "20000 random pairs", random_ok ? GREEN "✅" RESET : RED "❌" RESET);
+    passed += random_ok; num_tests++;
+    
+    printf("\n" BOLD "📊 TEST RESULTS: " GREEN "%d/%d PASSED" RESET "\n\n", passed, num_tests);
+    
+    // Performance test
+    printf(BOLD "⚡ PERFORMANCE BENCHMARK:" RESET "\n");
+    const char perf_str1[] __attribute__((aligned(16))) = "Sec-WebSocket-Extensions: permessage-deflate; client_max_window_bits";
+    const char perf_str2[] __attribute__((aligned(16))) = "sec-websocket-extensions: PERMESSAGE-DEFLATE; CLIENT_MAX_WINDOW_BITS";
+    const int CASE_ITERATIONS = 1000000;
+    printf("Comparing %zu-byte header lines " MAGENTA "%d" RESET " times...\n\n", strlen(perf_str1), CASE_ITERATIONS);
+    
+    clock_t start, end;
+    int result = 0;
+    
+    start = clock();
+    for (int i = 0; i < CASE_ITERATIONS; i++) result += ft_strcasecmp(perf_str1, perf_str2);
+    end = clock();
+    double asm_time = (double)(end - start) / CLOCKS_PER_SEC;
+    printf("🚀 Assembly ft_strcasecmp: " CYAN "%.6f seconds" RESET "\n", asm_time);
+    
+    start = clock();
+    for (int i = 0; i < CASE_ITERATIONS; i++) result += my_strncasecmp(perf_str1, perf_str2, (size_t)-1);
+    end = clock();
+    double my_time = (double)(end - start) / CLOCKS_PER_SEC;
+    printf("🔄 Simple C strcasecmp:    " CYAN "%.6f seconds" RESET "\n", my_time);
+    
+    start = clock();
+    for (int i = 0; i < CASE_ITERATIONS; i++) result += strcasecmp(perf_str1, perf_str2);
+    end = clock();
+    double libc_time = (double)(end - start) / CLOCKS_PER_SEC;
+    printf("⚡ libc strcasecmp:        " CYAN "%.6f seconds" RESET " (result %d)\n\n", libc_time, result);
+    
+    printf(BOLD "📊 PERFORMANCE COMPARISON:" RESET "\n");
+    printf("   Assembly vs C:     " YELLOW "%.2fx %s" RESET "\n",
+           my_time > asm_time ? my_time / asm_time : asm_time / my_time,
+           my_time > asm_time ? "faster" : "slower");
+    printf("   Assembly vs libc:  " YELLOW "%.2fx %s" RESET "\n",
+           libc_time > asm_time ? libc_time / asm_time : asm_time / libc_time,
+           libc_time > asm_time ? "faster" : "slower");
+}
+
+int my_utf8_validate(const unsigned char *s, size_t len) {
+    size_t i = 0;
+    while (i < len) {
+        unsigned char c = s[i];
+        size_t n;
+        unsigned char lo = 0x80, hi = 0xBF;
+        if (c < 0x80) { i++; continue; }
+        else if (c >= 0xC2 && c <= 0xDF) n = 1;
+        else if (c >= 0xE0 && c <= 0xEF) { n = 2; if (c == 0xE0) lo = 0xA0; if (c == 0xED) hi = 0x9F; }
+        else if (c >= 0xF0 && c <= 0xF4) { n = 3; if (c == 0xF0) lo = 0x90; if (c == 0xF4) hi = 0x8F; }
+        else return 0;
+        if (i + n >= len) return 0;
+        if (s[i + 1] < lo || s[i + 1] > hi) return 0;
+        for (size_t k = 2; k <= n; k++)
+            if ((s[i + k] & 0xC0) != 0x80) return 0;
+        i += n + 1;
+    }
+    return 1;
+}
+
+size_t my_utf8_strlen(const char *s) {
+    size_t count = 0;
+    for (; *s; s++)
+        if (((unsigned char)*s & 0xC0) != 0x80) count++;
+    return count;
+}
+
+void test_utf8_functionality() {
+    print_section("UTF-8 VALIDATION & COUNTING TEST");
+    
+    struct {
+        const char *bytes;
+        int valid;
+        const char *description;
+    } test_cases[] = {
+        {"Hello from ft_read! This is a test message. \xf0\x9f\x9a\x80\n", 1, "ft_read test content (emoji)"},
+        {"", 1, "Empty input"},
+        {"caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x8c\x8d \xf4\x8f\xbf\xbf", 1, "2/3/4-byte, U+10FFFF"},
+        {"\xed\x9f\xbf \xee\x80\x80", 1, "Around the surrogates"},
+        {"\xc0\xaf", 0, "Overlong 2-byte (C0 AF)"},
+        {"\xc1\xbf", 0, "Overlong 2-byte (C1 BF)"},
+        {"\xe0\x80\xaf", 0, "Overlong 3-byte (E0 80 AF)"},
+        {"\xe0\x9f\xbf", 0, "Overlong 3-byte (E0 9F BF)"},
+        {"\xf0\x80\x80\xaf", 0, "Overlong 4-byte (F0 80 80 AF)"},
+        {"\xf0\x8f\xbf\xbf", 0, "Overlong 4-byte (F0 8F BF BF)"},
+        {"\xed\xa0\x80", 0, "Surrogate U+D800"},
+        {"\xed\xbf\xbf", 0, "Surrogate U+DFFF"},
+        {"\xf4\x90\x80\x80", 0, "Above U+10FFFF"},
+        {"\xf5\x80\x80\x80", 0, "Invalid lead F5"},
+        {"\xff", 0, "Invalid byte FF"},
+        {"abc\x80", 0, "Stray continuation"},
+        {"\xe2\x82", 0, "Truncated at end"},
+        {"\xe2\x82" "abc", 0, "Truncated before ASCII"},
+        {"\xf0\x9f\x98", 0, "Truncated 4-byte"},
+        {"\xc3\xa9\xa9", 0, "Too many continuations"},
+        {"0123456789abcde\xc3\xa9", 1, "Sequence across 16 bytes"},
+        {"0123456789abcde\xe2\x82", 0, "Truncated across 16 bytes"},
+        {"0123456789abcdef\xe2\x82\xac", 1, "Sequence at block start"},
+        {"0123456789abcd\xf0\x9f\x98\x80" "0123456789abcdef", 1, "Emoji across blocks"},
+        {"0123456789abcd\xed\xa0\x80" "0123456789abcdef", 0, "Surrogate across blocks"}
+    };
+    
+    int num_tests = sizeof(test_cases) / sizeof(test_cases[0]);
+    
+    printf(BOLD "🧪 CORRECTNESS TESTS:" RESET "\n\n");
+    
+    int passed = 0;
+    for (int i = 0; i < num_tests; i++) {
+        size_t len = strlen(test_cases[i].bytes);
+        int ft_result = ft_utf8_validate(test_cases[i].bytes, len);
+        int my_result = my_utf8_validate((const unsigned char *)test_cases[i].bytes, len);
+        size_t ft_count = ft_utf8_strlen(test_cases[i].bytes);
+        int ok = ft_result == test_cases[i].valid && my_result == test_cases[i].valid
+                 && ft_count == my_utf8_strlen(test_cases[i].bytes);
+        printf("   %-30s %s | code points: %2zu %s\n", test_cases[i].description,
+               ft_result ? GREEN "valid  " RESET : YELLOW "invalid" RESET, ft_count, ok ? GREEN "✅" RESET : RED "❌" RESET);
+        if (ok) passed++;
+    }
+    
+    // Randomized comparison against the scalar reference at every length
+    const char *pieces[] = {"a", "\xc3\xa9", "\xe2\x82\xac", "\xf0\x9f\x9a\x80", "\xed\xa0\x80", "\xc0\x80",
+                            "\x80", "\xe2\x82", "\xf4\x90\x80\x80", "\xef\xbf\xbf", "0123456789"};
+    int random_ok = 1;
+    srand(7);
+    for (int i = 0; i < 20000 && random_ok; i++) {
+        char buf[128];
+        size_t len = 0;
+        while (len < 100) {
+            // Mostly valid pieces so long valid runs are exercised too
+            int k = (rand() % 10) ? (int[]){0, 1, 2, 3, 9, 10}[rand() % 6] : rand() % 11;
+            size_t n = strlen(pieces[k]);
+            memcpy(buf + len, pieces[k], n);
+            len += n;
+        }
+        buf[len] = '\0';
+        size_t cut = rand() % (len + 1);
+        if (ft_utf8_validate(buf, cut) != my_utf8_validate((unsigned char *)buf, cut)
+            || ft_utf8_strlen(buf) != my_utf8_strlen(buf))
+            random_ok = 0;
+    }
+    printf("   %-30s %s\n", "20000 random buffers", random_ok ? GREEN "✅" RESET : RED "❌" RESET);
+    passed += random_ok; num_tests++;
+    
+    printf("\n" BOLD "📊 TEST RESULTS: " GREEN "%d/%d PASSED" RESET "\n\n", passed, num_tests);
+    
+    // Performance test: 16 MB of mixed text
+    printf(BOLD "⚡ PERFORMANCE BENCHMARK:" RESET "\n");
+    const size_t size = 16 * 1024 * 1024;
+    const char sample[] = "Hello, \xe4\xb8\x96\xe7\x95\x8c! Caf\xc3\xa9 \xf0\x9f\x9a\x80 plain ascii text follows here. ";
+    char *text = malloc(size + 1);
+    size_t filled = 0;
+    while (filled + sizeof(sample) - 1 <= size) {
+        memcpy(text + filled, sample, sizeof(sample) - 1);
+        filled += sizeof(sample) - 1;
+    }
+    text[filled] = '\0';
+    printf("Input: " MAGENTA "%zu" RESET " bytes of mixed text, 10 passes each\n\n", filled);
+    
+    clock_t start, end;
+    int valid = 0;
+    size_t count = 0;
+    
+    start = clock();
+    for (int i = 0; i < 10; i++) valid += ft_utf8_validate(text, filled);
+    end = clock();
+    double asm_time = (double)(end - start) / CLOCKS_PER_SEC;
+    printf("🚀 ft_utf8_validate:  " CYAN "%.6f seconds" RESET " (" YELLOW "%.2f GB/s" RESET ")\n", asm_time, 10.0 * filled / asm_time / 1e9);
+    
+    start = clock();
+    for (int i = 0; i < 10; i++) valid += my_utf8_validate((unsigned char *)text, filled);
+    end = clock();
+    double my_time = (double)(end - start) / CLOCKS_PER_SEC;
+    printf("🔄 Simple C validate: " CYAN "%.6f seconds" RESET " (" YELLOW "%.2f GB/s" RESET ")\n", my_time, 10.0 * filled / my_time / 1e9);
+    
+    start = clock();
+    for (int i = 0; i < 10; i++) count += ft_utf8_strlen(text);
+    end = clock();
+    double count_time = (double)(end - start) / CLOCKS_PER_SEC;
+    printf("🚀 ft_utf8_strlen:    " CYAN "%.6f seconds" RESET " (" YELLOW "%.2f GB/s" RESET ")\n", count_time, 10.0 * filled / count_time / 1e9);
+    
+    start = clock();
+    for (int i = 0; i < 10; i++) count += my_utf8_strlen(text);
+    end = clock();
+    double my_count_time = (double)(end - start) / CLOCKS_PER_SEC;
+    printf("🔄 Simple C count:    " CYAN "%.6f seconds" RESET " (" YELLOW "%.2f GB/s" RESET ")\n\n", my_count_time, 10.0 * filled / my_count_time / 1e9);
+    
+    printf(BOLD "📊 PERFORMANCE COMPARISON:" RESET " (valid %d/20, %zu code points)\n", valid, count / 20);
+    printf("   Validate vs C:     " YELLOW "%.2fx faster" RESET "\n", my_time / asm_time);
+    printf("   Count vs C:        " YELLOW "%.2fx faster" RESET "\n", my_count_time / count_time);
+    free(text);
+}
+
+void test_split_functionality() {
+    print_section("TOKENIZER / SPLITTER TEST");
+    
+    struct {
+        const char *str;
+        const char *set;
+        const char *description;
+    } test_cases[] = {
+        {"   \t key = value", " \t", "Leading whitespace"},
+        {"key=value;other=1", "=;", "Config separators"},
+        {"no delimiters here at all, none", "|#", "No member"},
+        {"", " ", "Empty string"},
+        {"abc", "", "Empty set"},
+        {"2024-01-01T12:00:00Z INFO [main] request served in 12ms", " []", "Log line, > 16 bytes"},
+        {"\x01\x7f\x10 ctrl", "\x01\x7f\x10", "Control bytes"},
+        {"caf\xc3\xa9\xc2\xa0nbsp split", "\xc2\xa0 ", "Non-ASCII set (bitmap)"},
+        {"aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaab", "a", "Long span"}
+    };
+    
+    int num_tests = sizeof(test_cases) / sizeof(test_cases[0]);
+    
+    printf(BOLD "🧪 CORRECTNESS TESTS:" RESET "\n\n");
+    
+    int passed = 0;
+    for (int i = 0; i < num_tests; i++) {
+        size_t ft_spn = ft_strspn(test_cases[i].str, test_cases[i].set);
+        size_t ft_cspn = ft_strcspn(test_cases[i].str, test_cases[i].set);
+        size_t libc_spn = strspn(test_cases[i].str, test_cases[i].set);
+        size_t libc_cspn = strcspn(test_cases[i].str, test_cases[i].set);
+        int ok = ft_spn == libc_spn && ft_cspn == libc_cspn;
+        printf("   %-26s spn: %2zu/%2zu | cspn: %2zu/%2zu %s\n", test_cases[i].description,
+               ft_spn, libc_spn, ft_cspn, libc_cspn, ok ? GREEN "✅" RESET : RED "❌" RESET);
+        if (ok) passed++;
+    }
+    
+    // ft_strtok_r against libc strtok_r
+    const char *tok_inputs[] = {"  GET /index.html  HTTP/1.1 ", "a,b,,c,", ",,,", "single", ""};
+    int tok_ok = 1;
+    for (size_t i = 0; i < sizeof(tok_inputs) / sizeof(tok_inputs[0]); i++) {
+        char ft_buf[64], libc_buf[64];
+        strcpy(ft_buf, tok_inputs[i]);
+        strcpy(libc_buf, tok_inputs[i]);
+        char *ft_save, *libc_save;
+        char *ft_tok = ft_strtok_r(ft_buf, " ,", &ft_save);
+        char *libc_tok = strtok_r(libc_buf, " ,", &libc_save);
+        while (ft_tok || libc_tok) {
+            if (!ft_tok || !libc_tok || strcmp(ft_tok, libc_tok) != 0 || ft_tok - ft_buf != libc_tok - libc_buf)
+                tok_ok = 0;
+            if (!ft_tok || !libc_tok) break;
+            ft_tok = ft_strtok_r(NULL, " ,", &ft_save);
+            libc_tok = strtok_r(NULL, " ,", &libc_save);
+        }
+    }
+    printf("   %-26s %s\n", "ft_strtok_r vs libc", tok_ok ? GREEN "✅" RESET : RED "❌" RESET);
+    passed += tok_ok; num_tests++;
+    
+    // Zero-copy iterator: bounded by length, source left untouched
+    const char line[] = "user=alice;;role=admin;id=42;trailing";
+    const char *expected[] = {"user=alice", "role=admin", "id=42"};
+    t_ft_split it;
+    const char *token;
+    size_t len;
+    int count = 0, split_ok = 1;
+    ft_split_init(&it, line, strlen(line) - 9, ";");   // stops before ";trailing"
+    while (ft_split_next(&it, &token, &len)) {
+        if (count >= 3 || len != strlen(expected[count]) || strncmp(token, expected[count], len) != 0)
+            split_ok = 0;
+        count++;
+    }
+    split_ok = split_ok && count == 3 && strcmp(line, "user=alice;;role=admin;id=42;trailing") == 0;
+    printf("   %-26s %d tokens %s\n", "ft_split_next (bounded)", count, split_ok ? GREEN "✅" RESET : RED "❌" RESET);
+    passed += split_ok; num_tests++;
+    
+    // Strings ending right before an unmapped page
+    char *pages = mmap(NULL, 8192, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    mprotect(pages + 4096, 4096, PROT_NONE);
+    char *edge = pages + 4096 - 8;
+    strcpy(edge, "  ab,cd");
+    ft_split_init(&it, edge, 7, " ,");
+    count = 0;
+    while (ft_split_next(&it, &token, &len)) count++;
+    int edge_ok = ft_strspn(edge, " ") == 2 && ft_strcspn(edge, ";") == 7 && count == 2;
+    printf("   %-26s %s\n", "Page boundary", edge_ok ? GREEN "✅" RESET : RED "❌" RESET);
+    passed += edge_ok; num_tests++;
+    munmap(pages, 8192);
+    
+    // Randomized comparison against libc at every alignment
+    const char alphabet[] = "ab ,;\t\xc3\xa9";
+    const char *sets[] = {" ", " ,;\t", "ab", ",\xc3", "\t;"};
+    int random_ok = 1;
+    srand(1234);
+    for (int i = 0; i < 20000 && random_ok; i++) {
+        char buf[96];
+        char *str = buf + rand() % 16;
+        int slen = rand() % 64;
+        for (int j = 0; j < slen; j++) str[j] = alphabet[rand() % 8];
+        str[slen] = '\0';
+        const char *set = sets[rand() % 5];
+        if (ft_strspn(str, set) != strspn(str, set) || ft_strcspn(str, set) != strcspn(str, set))
+            random_ok = 0;
+        // Iterator tokens must match strtok_r on a copy
+        char copy[96], *save;
+        strcpy(copy, str);
+        char *ref = strtok_r(copy, set, &save);
+        ft_split_init(&it, str, slen, set);
+        while (ft_split_next(&it, &token, &len)) {
+            if (!ref || strlen(ref) != len || strncmp(ref, token, len) != 0) random_ok = 0;
+            ref = ref ? strtok_r(NULL, set, &save) : NULL;
+        }
+        if (ref) random_ok = 0;
+    }
+    printf("   %-26s %s\n", "20000 random strings", random_ok ? GREEN "✅" RESET : RED "❌" RESET);
+    passed += random_ok; num_tests++;
+    
+    printf("\n" BOLD "📊 TEST RESULTS: " GREEN "%d/%d PASSED" RESET "\n\n", passed, num_tests);
+    
+    // Performance test: split a log buffer into fields
+    printf(BOLD "⚡ PERFORMANCE BENCHMARK:" RESET "\n");
+    const size_t size = 16 * 1024 * 1024;
+    const char log_line[] = "2024-01-01T12:00:00Z INFO [worker-17] request_id=9f1c2 path=/api/v1/items status=200 bytes=5123\n";
+    char *text = malloc(size + 1);
+    char *copy = malloc(size + 1);
+    size_t filled = 0;
+    while (filled + sizeof(log_line) - 1 <= size) {
+        memcpy(text + filled, log_line, sizeof(log_line) - 1);
+        filled += sizeof(log_line) - 1;
+    }
+    text[filled] = '\0';
+    const char *delims = " \n[]=";
+    printf("Splitting " MAGENTA "%zu" RESET " bytes of log lines on \" \\n[]=\"...\n\n", filled);
+    
+    clock_t start, end;
+    size_t ft_tokens = 0, libc_tokens = 0;
+    
+    start = clock();
+    ft_split_init(&it, text, filled, delims);
+    while (ft_split_next(&it, &token, &len)) ft_tokens++;
+    end = clock();
+    double split_time = (double)(end - start) / CLOCKS_PER_SEC;
+    printf("🚀 ft_split_next:   " CYAN "%.6f seconds" RESET " (%zu tokens, zero-copy)\n", split_time, ft_tokens);
+    
+    memcpy(copy, text, filled + 1);
+    start = clock();
+    char *save;
+    for (char *t = ft_strtok_r(copy, delims, &save); t; t = ft_strtok_r(NULL, delims, &save)) ;
+    end = clock();
+    double tok_time = (double)(end - start) / CLOCKS_PER_SEC;
+    printf("🚀 ft_strtok_r:     " CYAN "%.6f seconds" RESET "\n", tok_time);
+    
+    memcpy(copy, text, filled + 1);
+    start = clock();
+    for (char *t = strtok_r(copy, delims, &save); t; t = strtok_r(NULL, delims, &save)) libc_tokens++;
+    end = clock();
+    double libc_time = (double)(end - start) / CLOCKS_PER_SEC;
+    printf("⚡ libc strtok_r:   " CYAN "%.6f seconds" RESET " (%zu tokens)\n\n", libc_time, libc_tokens);
+    
+    printf(BOLD "📊 PERFORMANCE COMPARISON:" RESET "\n");
+    printf("   ft_split vs libc:  " YELLOW "%.2fx %s" RESET "\n",
+           libc_time > split_time ? libc_time / split_time : split_time / libc_time,
+           libc_time > split_time ? "faster" : "slower");
+    printf("   ft_strtok_r vs libc: " YELLOW "%.2fx %s" RESET "\n",
+           libc_time > tok_time ? libc_time / tok_time : tok_time / libc_time,
+           libc_time > tok_time ? "faster" : "slower");
+    free(text);
+    free(copy);
+}
+
 int main() {
     print_header("LIBASM FUNCTION TESTER");
     
     test_strlen_performance();
     test_strcpy_functionality();
     test_strcmp_functionality();
+    test_case_functionality();
+    test_utf8_functionality();
+    test_split_functionality();
     test_write_functionality();
     test_read_functionality();
+    test_raw_io_functionality();
     test_strdup_functionality();
+    test_str_functionality();
+    test_builder_functionality();
+    test_loop_functionality();
     
     printf("\n" BOLD GREEN "🎉 All tests completed!" RESET "\n");
     